@@ -1,6 +1,8 @@
 #include <string>
 #include <iostream>
 #include <functional>
+#include <vector>
+#include <algorithm>
 
 // Enum for movie genres using bitwise flags
 enum EMovieGenreType {
@@ -91,6 +93,54 @@ public:
 		}
 	}
 
+	// Append a range of movies in one pass (O(count))
+	// The chain is linked off-list first and attached to the tail with a single splice
+	void AppendRange(TMovie* const* movies, int count) {
+		if (!movies || count <= 0) return;
+		TMovieNode* first = new TMovieNode(movies[0]);
+		TMovieNode* last = first;
+		for (int i = 1; i < count; ++i) {
+			TMovieNode* node = new TMovieNode(movies[i]);
+			node->SetPrev(last);
+			last->SetNext(node);
+			last = node;
+		}
+		first->SetPrev(tail);
+		tail->SetNext(first);
+		tail = last;
+	}
+
+	// Move every node of other to the end of this list (O(1)); other is left empty
+	void Splice(TMovieList& other) {
+		if (&other == this) return;
+		TMovieNode* first = other.head->GetNext();
+		if (!first) return;
+		first->SetPrev(tail);
+		tail->SetNext(first);
+		tail = other.tail;
+		other.head->SetNext(nullptr);
+		other.tail = other.head;
+	}
+
+	// Split the list at index (0-based, not counting dummy) (O(index))
+	// Nodes from index onwards are moved to the returned list; caller must delete it
+	TMovieList* Split(int index) {
+		TMovieList* rest = new TMovieList();
+		if (index < 0) index = 0;
+		TMovieNode* current = head->GetNext();
+		for (int i = 0; current && i < index; ++i) {
+			current = current->GetNext();
+		}
+		if (!current) return rest;
+		TMovieNode* last = current->GetPrev();
+		last->SetNext(nullptr);
+		rest->head->SetNext(current);
+		current->SetPrev(rest->head);
+		rest->tail = tail;
+		tail = last;
+		return rest;
+	}
+
 	// Get movie at index (0-based, not counting dummy)
 	TMovie* GetAtIndex(int index) const {
 		TMovieNode* current = head->GetNext();
@@ -140,6 +190,36 @@ public:
 		if (prevNode) prevNode->SetPrev(head);
 	}
 
+	// Reverse the nodes from index first to index last (inclusive, 0-based) in-place
+	// Time: O(last), out-of-range indices are clamped to the list
+	void Reverse(int first, int last) {
+		if (first < 0) first = 0;
+		if (last <= first) return;
+		TMovieNode* start = head->GetNext();
+		int i = 0;
+		for (; start && i < first; ++i) start = start->GetNext();
+		if (!start) return;
+		TMovieNode* before = start->GetPrev();
+		TMovieNode* current = start;
+		TMovieNode* prevNode = before;
+		for (; current && i <= last; ++i) {
+			TMovieNode* next = current->GetNext();
+			current->SetNext(prevNode);
+			current->SetPrev(next);
+			prevNode = current;
+			current = next;
+		}
+		// prevNode is the new first node of the range, start is its new last node
+		before->SetNext(prevNode);
+		prevNode->SetPrev(before);
+		start->SetNext(current);
+		if (current) {
+			current->SetPrev(start);
+		} else {
+			tail = start;
+		}
+	}
+
 	// Search for a movie using a callback
 	TMovie* SearchFor(FCheckMovie check) const {
 		TMovieNode* current = head->GetNext();
@@ -152,6 +232,35 @@ public:
 		}
 		return nullptr;
 	}
+
+	// Return the n highest scoring movies (best first), optionally filtered by a callback
+	// Streams the list once keeping a bounded min-heap of size n
+	// Time: O(m log n), Space: O(n)
+	std::vector<TMovie*> TopByScore(int n, FCheckMovie filter = nullptr) const {
+		std::vector<TMovie*> heap;
+		if (n <= 0) return heap;
+		heap.reserve(n);
+		// Comparator puts the lowest score at the front of the heap
+		auto higherScore = [](const TMovie* a, const TMovie* b) { return a->GetScore() > b->GetScore(); };
+		TMovieNode* current = head->GetNext();
+		while (current) {
+			TMovie* movie = current->GetMovie();
+			if (movie && (!filter || filter(movie))) {
+				if ((int)heap.size() < n) {
+					heap.push_back(movie);
+					std::push_heap(heap.begin(), heap.end(), higherScore);
+				} else if (movie->GetScore() > heap.front()->GetScore()) {
+					std::pop_heap(heap.begin(), heap.end(), higherScore);
+					heap.back() = movie;
+					std::push_heap(heap.begin(), heap.end(), higherScore);
+				}
+			}
+			current = current->GetNext();
+		}
+		// Sorting the heap itself is O(n log n) and leaves the best movie first
+		std::sort_heap(heap.begin(), heap.end(), higherScore);
+		return heap;
+	}
 };
 
 // Global search functions
@@ -170,6 +279,11 @@ bool SearchByGenre(const TMovie* movie) {
 	return (movie->GetGenre() & ACTION) != 0;
 }
 
+bool SearchBySciFi(const TMovie* movie) {
+	// Example: filter on SCIFI genre for ranking queries
+	return (movie->GetGenre() & SCIFI) != 0;
+}
+
 // Example usage and test code
 int main() {
 	// Create a movie list
@@ -206,6 +320,65 @@ int main() {
 		std::cout << i << ": " << m->GetTitle() << std::endl;
 	}
 
+	// Bulk load two shards and stitch them onto the list
+	TMovie* shardA[] = {
+		new TMovie("Alien", "Scott", 1979, (EMovieGenreType)(HORROR | SCIFI), 8.5f),
+		new TMovie("Heat", "Mann", 1995, (EMovieGenreType)(ACTION | DRAMA), 8.3f)
+	};
+	TMovie* shardB[] = {
+		new TMovie("Arrival", "Villeneuve", 2016, (EMovieGenreType)(DRAMA | SCIFI), 7.9f),
+		new TMovie("Airplane!", "Abrahams", 1980, COMEDY, 7.7f)
+	};
+	TMovieList shardListA;
+	TMovieList shardListB;
+	shardListA.AppendRange(shardA, 2);
+	shardListB.AppendRange(shardB, 2);
+	shardListA.Splice(shardListB);
+	movieList.Splice(shardListA);
+	std::cout << "\nAfter splicing two bulk-loaded shards:" << std::endl;
+	for (int i = 0; ; ++i) {
+		TMovie* m = movieList.GetAtIndex(i);
+		if (!m) break;
+		std::cout << i << ": " << m->GetTitle() << std::endl;
+	}
+
+	// Reverse the spliced shards only
+	movieList.Reverse(2, 5);
+	std::cout << "\nAfter reversing index 2 to 5:" << std::endl;
+	for (int i = 0; ; ++i) {
+		TMovie* m = movieList.GetAtIndex(i);
+		if (!m) break;
+		std::cout << i << ": " << m->GetTitle() << std::endl;
+	}
+
+	// Split the shards off again
+	TMovieList* tailList = movieList.Split(2);
+	std::cout << "\nAfter splitting at index 2:" << std::endl;
+	for (int i = 0; ; ++i) {
+		TMovie* m = movieList.GetAtIndex(i);
+		if (!m) break;
+		std::cout << "list " << i << ": " << m->GetTitle() << std::endl;
+	}
+	for (int i = 0; ; ++i) {
+		TMovie* m = tailList->GetAtIndex(i);
+		if (!m) break;
+		std::cout << "split " << i << ": " << m->GetTitle() << std::endl;
+	}
+	movieList.Splice(*tailList);
+	delete tailList;
+
+	// Rank movies by score
+	std::vector<TMovie*> top = movieList.TopByScore(3);
+	std::cout << "\nTop 3 by score:" << std::endl;
+	for (size_t i = 0; i < top.size(); ++i) {
+		std::cout << i << ": " << top[i]->GetTitle() << " Score: " << top[i]->GetScore() << std::endl;
+	}
+	top = movieList.TopByScore(20, SearchBySciFi);
+	std::cout << "\nTop 20 SCIFI by score:" << std::endl;
+	for (size_t i = 0; i < top.size(); ++i) {
+		std::cout << i << ": " << top[i]->GetTitle() << " Score: " << top[i]->GetScore() << std::endl;
+	}
+
 	// Search for a movie by title
 	TMovie* found = movieList.SearchFor(SearchByTitle);
 	if (found) {
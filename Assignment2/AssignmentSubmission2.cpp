@@ -3,6 +3,23 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#include <limits>
+#include <random>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 // Prints all natural numbers from 1 to n using recursion
 // Time: O(n), Space: O(n) due to call stack
@@ -39,6 +56,247 @@ int fibonacci(int n) {
 }
 // Note: This naive recursive solution is inefficient because it recalculates the same subproblems many times. Using memoization or iteration would improve performance to O(n).
 
+// Arbitrary-precision unsigned integer stored as little-endian base 10^9 limbs
+// Base 10^9 keeps every limb product inside 64 bits and makes decimal output trivial
+class TBigInt {
+private:
+    static const uint32_t BASE = 1000000000;
+    // Operands shorter than this use schoolbook multiplication
+    static const size_t KARATSUBA_THRESHOLD = 32;
+    std::vector<uint32_t> limbs; // Empty means zero
+
+    void Trim() {
+        while (!limbs.empty() && limbs.back() == 0) limbs.pop_back();
+    }
+
+    // Adds x into r starting at limb offset, growing r as needed
+    static void AddInto(std::vector<uint32_t>& r, const std::vector<uint32_t>& x, size_t offset) {
+        if (r.size() < offset + x.size()) r.resize(offset + x.size(), 0);
+        uint32_t carry = 0;
+        size_t i = 0;
+        for (; i < x.size() || carry; ++i) {
+            if (offset + i == r.size()) r.push_back(0);
+            uint32_t sum = r[offset + i] + carry + (i < x.size() ? x[i] : 0);
+            carry = sum >= BASE ? 1 : 0;
+            r[offset + i] = carry ? sum - BASE : sum;
+        }
+    }
+
+    // Subtracts x from r in place, requires r >= x
+    static void SubInPlace(std::vector<uint32_t>& r, const std::vector<uint32_t>& x) {
+        uint32_t borrow = 0;
+        for (size_t i = 0; i < x.size() || borrow; ++i) {
+            uint32_t sub = borrow + (i < x.size() ? x[i] : 0);
+            borrow = r[i] < sub ? 1 : 0;
+            r[i] = borrow ? r[i] + BASE - sub : r[i] - sub;
+        }
+    }
+
+    // Time: O(n*m)
+    static std::vector<uint32_t> MulSchool(const uint32_t* a, size_t n, const uint32_t* b, size_t m) {
+        std::vector<uint32_t> r(n + m, 0);
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < m; ++j) {
+                uint64_t cur = r[i + j] + (uint64_t)a[i] * b[j] + carry;
+                r[i + j] = (uint32_t)(cur % BASE);
+                carry = cur / BASE;
+            }
+            r[i + m] = (uint32_t)carry;
+        }
+        return r;
+    }
+
+    // Karatsuba multiplication, falls back to schoolbook below the threshold
+    // Time: O(n^1.585)
+    static std::vector<uint32_t> Mul(const uint32_t* a, size_t n, const uint32_t* b, size_t m) {
+        if (n < m) { std::swap(a, b); std::swap(n, m); }
+        if (m == 0) return std::vector<uint32_t>();
+        if (m < KARATSUBA_THRESHOLD) return MulSchool(a, n, b, m);
+        if (2 * m <= n) {
+            // Unbalanced operands: multiply b by m-limb slices of a
+            std::vector<uint32_t> r(n + m, 0);
+            for (size_t off = 0; off < n; off += m) {
+                size_t len = (n - off < m) ? n - off : m;
+                AddInto(r, Mul(a + off, len, b, m), off);
+            }
+            return r;
+        }
+        // Both operands have a non-empty high half when split at k
+        size_t k = n / 2;
+        std::vector<uint32_t> z0 = Mul(a, k, b, k);
+        std::vector<uint32_t> z2 = Mul(a + k, n - k, b + k, m - k);
+        std::vector<uint32_t> sa(a, a + k), sb(b, b + k);
+        AddInto(sa, std::vector<uint32_t>(a + k, a + n), 0);
+        AddInto(sb, std::vector<uint32_t>(b + k, b + m), 0);
+        std::vector<uint32_t> z1 = Mul(sa.data(), sa.size(), sb.data(), sb.size());
+        SubInPlace(z1, z0);
+        SubInPlace(z1, z2);
+        std::vector<uint32_t> r(n + m + 1, 0);
+        AddInto(r, z0, 0);
+        AddInto(r, z1, k);
+        AddInto(r, z2, 2 * k);
+        return r;
+    }
+
+public:
+    TBigInt(uint64_t value = 0) {
+        while (value > 0) {
+            limbs.push_back((uint32_t)(value % BASE));
+            value /= BASE;
+        }
+    }
+
+    bool IsZero() const { return limbs.empty(); }
+
+    TBigInt operator+(const TBigInt& other) const {
+        TBigInt r(*this);
+        AddInto(r.limbs, other.limbs, 0);
+        return r;
+    }
+
+    // Requires *this >= other, the type is unsigned
+    TBigInt operator-(const TBigInt& other) const {
+        TBigInt r(*this);
+        SubInPlace(r.limbs, other.limbs);
+        r.Trim();
+        return r;
+    }
+
+    TBigInt operator*(const TBigInt& other) const {
+        TBigInt r;
+        r.limbs = Mul(limbs.data(), limbs.size(), other.limbs.data(), other.limbs.size());
+        r.Trim();
+        return r;
+    }
+
+    // Multiplies by a small factor in place, factor must be below 2^32
+    // Time: O(n)
+    void MulSmall(uint32_t factor) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); ++i) {
+            uint64_t cur = (uint64_t)limbs[i] * factor + carry;
+            limbs[i] = (uint32_t)(cur % BASE);
+            carry = cur / BASE;
+        }
+        while (carry > 0) {
+            limbs.push_back((uint32_t)(carry % BASE));
+            carry /= BASE;
+        }
+        Trim();
+    }
+
+    bool operator==(const TBigInt& other) const { return limbs == other.limbs; }
+    bool operator!=(const TBigInt& other) const { return limbs != other.limbs; }
+
+    // Number of decimal digits (1 for zero)
+    size_t DigitCount() const {
+        if (limbs.empty()) return 1;
+        size_t digits = (limbs.size() - 1) * 9;
+        for (uint32_t top = limbs.back(); top > 0; top /= 10) ++digits;
+        return digits;
+    }
+
+    std::string ToString() const {
+        if (limbs.empty()) return "0";
+        std::string result = std::to_string(limbs.back());
+        for (size_t i = limbs.size() - 1; i-- > 0;) {
+            std::string part = std::to_string(limbs[i]);
+            result.append(9 - part.size(), '0');
+            result += part;
+        }
+        return result;
+    }
+};
+
+// Compile-time tables for small n, built from C++11 constexpr recursion
+constexpr uint64_t fibonacciStep(int n, uint64_t a, uint64_t b) {
+    return n == 0 ? a : fibonacciStep(n - 1, b, a + b);
+}
+constexpr uint64_t fibonacciConstexpr(int n) { return fibonacciStep(n, 0, 1); }
+constexpr uint64_t factorialConstexpr(int n) { return n <= 1 ? 1 : n * factorialConstexpr(n - 1); }
+
+template<int... I> struct TIndexList {};
+template<int N, int... I> struct TMakeIndexList : TMakeIndexList<N - 1, N - 1, I...> {};
+template<int... I> struct TMakeIndexList<0, I...> { typedef TIndexList<I...> type; };
+
+template<uint64_t (*F)(int), typename List> struct TConstexprTable;
+template<uint64_t (*F)(int), int... I>
+struct TConstexprTable<F, TIndexList<I...> > {
+    static constexpr int size = sizeof...(I);
+    static constexpr uint64_t values[sizeof...(I)] = { F(I)... };
+};
+template<uint64_t (*F)(int), int... I>
+constexpr uint64_t TConstexprTable<F, TIndexList<I...> >::values[sizeof...(I)];
+
+// fib(93) and 20! are the largest values that fit in 64 bits
+typedef TConstexprTable<fibonacciConstexpr, TMakeIndexList<94>::type> TFibonacciTable;
+typedef TConstexprTable<factorialConstexpr, TMakeIndexList<21>::type> TFactorialTable;
+static_assert(TFibonacciTable::values[93] == 12200160415121876738ULL, "fib(93) table entry");
+static_assert(TFactorialTable::values[20] == 2432902008176640000ULL, "20! table entry");
+
+// Returns the n-th Fibonacci number using fast doubling:
+// F(2k) = F(k) * (2F(k+1) - F(k)), F(2k+1) = F(k)^2 + F(k+1)^2
+// Time: O(log n) big multiplications, Space: O(1) besides the result
+TBigInt fastFibonacci(int n) {
+    if (n < 0) return TBigInt(0);
+    if (n < TFibonacciTable::size) return TBigInt(TFibonacciTable::values[n]);
+    TBigInt a(0), b(1); // F(k), F(k+1) with k = 0
+    int bit = 30;
+    while (!((n >> bit) & 1)) --bit;
+    for (; bit >= 0; --bit) {
+        TBigInt c = a * (b + b - a); // F(2k)
+        TBigInt d = a * a + b * b;   // F(2k+1)
+        if ((n >> bit) & 1) {
+            a = d;
+            b = c + d;
+        } else {
+            a = c;
+            b = d;
+        }
+    }
+    return a;
+}
+
+// Calculates n! iteratively with a balanced product tree
+// Consecutive factors are packed into single limbs first, then multiplied pairwise so that
+// the large multiplications have equal-sized operands and benefit from Karatsuba
+// Time: O(M(n log n) log n), Space: O(n log n) bits
+TBigInt bigFactorial(int n) {
+    if (n < 0) return TBigInt(0);
+    if (n < TFactorialTable::size) return TBigInt(TFactorialTable::values[n]);
+    std::vector<TBigInt> level;
+    uint64_t packed = 1;
+    for (int i = 2; i <= n; ++i) {
+        if (packed * (uint64_t)i >= 1000000000ULL) {
+            level.push_back(TBigInt(packed));
+            packed = 1;
+        }
+        packed *= (uint64_t)i;
+    }
+    level.push_back(TBigInt(packed));
+    while (level.size() > 1) {
+        std::vector<TBigInt> next;
+        next.reserve(level.size() / 2 + 1);
+        for (size_t i = 0; i + 1 < level.size(); i += 2) next.push_back(level[i] * level[i + 1]);
+        if (level.size() % 2 == 1) next.push_back(level.back());
+        level.swap(next);
+    }
+    return level[0];
+}
+
+// Calculates base raised to exponent iteratively by square-and-multiply
+// Time: O(log n) big multiplications
+TBigInt bigPower(uint32_t base, unsigned exponent) {
+    TBigInt result(1), square(base);
+    while (exponent > 0) {
+        if (exponent & 1) result = result * square;
+        exponent >>= 1;
+        if (exponent > 0) square = square * square;
+    }
+    return result;
+}
+
 // Counts occurrences of character c in string s using recursion
 // Time: O(n), Space: O(n) due to call stack
 int countOccurrences(const std::string& s, char c) {
@@ -47,6 +305,154 @@ int countOccurrences(const std::string& s, char c) {
     return count + countOccurrences(s.substr(1), c); // Recursive step
 }
 
+// Stack-depth-safe versions of the recursive functions above
+// They produce the same output without one call frame per element
+
+// Prints all natural numbers from 1 to n with a loop
+// Time: O(n), Space: O(1)
+void printNaturalNumbersIterative(int n) {
+    for (int i = 1; i <= n; ++i) std::cout << i << " ";
+}
+
+// Counts occurrences of character c in s by indexing instead of copying suffixes
+// Time: O(n), Space: O(1)
+int countOccurrencesIterative(const std::string& s, char c) {
+    int count = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == c) ++count;
+    }
+    return count;
+}
+
+// Prints ASCII characters from start to end and back using an explicit stack
+// Each frame remembers whether its pre-order output was already written
+// Time: O(n), Space: O(n) heap, O(1) call stack
+void traverseAsciiTableIterative(char start, char end) {
+    struct TFrame { char value; bool unwinding; };
+    std::vector<TFrame> stack;
+    if (start <= end) stack.push_back(TFrame{start, false});
+    while (!stack.empty()) {
+        TFrame& frame = stack.back();
+        if (frame.unwinding) {
+            std::cout << frame.value << " "; // Post-order output
+            stack.pop_back();
+            continue;
+        }
+        frame.unwinding = true;
+        std::cout << frame.value << " "; // Pre-order output
+        char value = frame.value;
+        if (value < end) stack.push_back(TFrame{(char)(value + 1), false});
+    }
+}
+
+// Vectorized counting for large buffers (log scanning)
+// Each step compares 64 bytes against the target and counts the movemask bits
+
+inline unsigned popCount32(unsigned mask) {
+#if defined(_MSC_VER)
+    return __popcnt(mask);
+#else
+    return (unsigned)__builtin_popcount(mask);
+#endif
+}
+
+// Returns a bitmask with one bit per byte of the 64-byte block that equals c
+inline uint64_t matchMask64(const char* block, char c) {
+#if defined(__AVX2__)
+    const __m256i target = _mm256_set1_epi8(c);
+    uint64_t lo = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)block), target));
+    uint64_t hi = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(block + 32)), target));
+    return lo | (hi << 32);
+#elif defined(__SSE2__)
+    const __m128i target = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(block + 16 * i));
+        mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target)) << (16 * i);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; ++i) mask |= (uint64_t)(block[i] == c) << i;
+    return mask;
+#endif
+}
+
+// Counts occurrences of c in data[0, size) 64 bytes per step
+// Time: O(n), Space: O(1)
+size_t countOccurrencesSimd(const char* data, size_t size, char c) {
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        uint64_t mask = matchMask64(data + i, c);
+        count += popCount32((unsigned)mask) + popCount32((unsigned)(mask >> 32));
+    }
+    for (; i < size; ++i) count += (data[i] == c);
+    return count;
+}
+
+// Counts bytes of data[0, size) that are any of the characters in set, in one pass
+// Small sets OR the per-character masks, larger sets use a 256-entry lookup table
+// Time: O(n * k) for k <= 8 characters, O(n) otherwise
+size_t countAnyOfSimd(const char* data, size_t size, const std::string& set) {
+    size_t count = 0;
+    if (set.size() <= 8) {
+        size_t i = 0;
+        for (; i + 64 <= size; i += 64) {
+            uint64_t mask = 0;
+            for (size_t k = 0; k < set.size(); ++k) mask |= matchMask64(data + i, set[k]);
+            count += popCount32((unsigned)mask) + popCount32((unsigned)(mask >> 32));
+        }
+        for (; i < size; ++i) count += set.find(data[i]) != std::string::npos;
+        return count;
+    }
+    bool table[256] = {false};
+    for (size_t k = 0; k < set.size(); ++k) table[(unsigned char)set[k]] = true;
+    for (size_t i = 0; i < size; ++i) count += table[(unsigned char)data[i]];
+    return count;
+}
+
+// Buffers below this size are counted on the calling thread
+const size_t PARALLEL_COUNT_THRESHOLD = 4u * 1024u * 1024u;
+
+// Splits the buffer into one chunk per thread and sums the per-chunk SIMD counts
+// Time: O(n / threads), Space: O(threads)
+size_t countOccurrencesParallel(const std::string& s, char c, unsigned threadCount = 0) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    if (s.size() < PARALLEL_COUNT_THRESHOLD || threadCount == 1) return countOccurrencesSimd(s.data(), s.size(), c);
+    std::vector<size_t> partial(threadCount, 0);
+    std::vector<std::thread> workers;
+    size_t chunk = (s.size() + threadCount - 1) / threadCount;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        size_t begin = std::min(s.size(), t * chunk);
+        size_t length = std::min(chunk, s.size() - begin);
+        workers.push_back(std::thread([&s, &partial, c, t, begin, length]() {
+            partial[t] = countOccurrencesSimd(s.data() + begin, length, c);
+        }));
+    }
+    size_t total = 0;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        workers[t].join();
+        total += partial[t];
+    }
+    return total;
+}
+
+// Returns the peak resident set size of the process in kilobytes, or -1 if unknown
+long peakMemoryKb() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // macOS reports bytes
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
 // Finds the largest element in an array using divide and conquer recursion
 // Time: O(n), Space: O(log n) due to call stack (for balanced splits)
 int findLargestElement(int arr[], int left, int right) {
@@ -57,6 +463,89 @@ int findLargestElement(int arr[], int left, int right) {
     return (maxLeft > maxRight) ? maxLeft : maxRight;
 }
 
+// Generic parallel divide-and-conquer reduction
+// Splits [begin, end) in halves like findLargestElement, forking the left half onto a new
+// thread while the tree is shallower than forkDepth and the range is above the grain size.
+// Leaves run a plain loop that the compiler can vectorize.
+// combine must be associative, leaf(begin, end) reduces one subrange serially.
+// Time: O(n / threads + log n), Space: O(log n)
+template<typename Value, typename Leaf, typename Combine>
+Value parallelReduceRange(size_t begin, size_t end, Leaf leaf, Combine combine, size_t grain, int forkDepth) {
+    if (end - begin <= grain || forkDepth <= 0) return leaf(begin, end);
+    size_t mid = begin + (end - begin) / 2;
+    Value leftValue;
+    std::thread leftThread([&]() {
+        leftValue = parallelReduceRange<Value>(begin, mid, leaf, combine, grain, forkDepth - 1);
+    });
+    Value rightValue = parallelReduceRange<Value>(mid, end, leaf, combine, grain, forkDepth - 1);
+    leftThread.join();
+    return combine(leftValue, rightValue);
+}
+
+// Fork depth that gives roughly one leaf per hardware thread
+inline int defaultForkDepth() {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    int depth = 0;
+    while ((1u << depth) < threads) ++depth;
+    return depth;
+}
+
+const size_t DEFAULT_REDUCE_GRAIN = 64u * 1024u;
+
+// Associative operators for parallelReduce
+template<typename T> struct TMaxOp { T operator()(const T& a, const T& b) const { return a < b ? b : a; } };
+template<typename T> struct TMinOp { T operator()(const T& a, const T& b) const { return b < a ? b : a; } };
+template<typename T> struct TSumOp { T operator()(const T& a, const T& b) const { return a + b; } };
+
+// Projection that reduces the elements themselves
+template<typename T> struct TIdentity { const T& operator()(const T& value) const { return value; } };
+
+// Reduces project(data[i]) over an array of any element type with an associative operator
+template<typename Value, typename Element, typename Projection, typename Combine>
+Value parallelReduce(const Element* data, size_t count, Value identity, Projection project, Combine combine,
+                     size_t grain = DEFAULT_REDUCE_GRAIN) {
+    auto leaf = [data, identity, project, combine](size_t begin, size_t end) {
+        Value acc = identity;
+        for (size_t i = begin; i < end; ++i) acc = combine(acc, (Value)project(data[i]));
+        return acc;
+    };
+    return parallelReduceRange<Value>(0, count, leaf, combine, grain, defaultForkDepth());
+}
+
+// Result of an argmax/argmin reduction, index is count when the input is empty
+template<typename Value> struct TArgResult {
+    Value value;
+    size_t index;
+};
+
+// Returns the largest projected value and the lowest index holding it
+template<typename Value, typename Element, typename Projection>
+TArgResult<Value> parallelArgMax(const Element* data, size_t count, Projection project,
+                                 size_t grain = DEFAULT_REDUCE_GRAIN) {
+    auto combine = [](const TArgResult<Value>& a, const TArgResult<Value>& b) {
+        if (a.index == (size_t)-1) return b;
+        if (b.index == (size_t)-1) return a;
+        return (b.value > a.value || (!(a.value > b.value) && b.index < a.index)) ? b : a;
+    };
+    auto leaf = [data, project](size_t begin, size_t end) {
+        TArgResult<Value> best = { Value(), (size_t)-1 };
+        for (size_t i = begin; i < end; ++i) {
+            Value value = (Value)project(data[i]);
+            if (best.index == (size_t)-1 || value > best.value) { best.value = value; best.index = i; }
+        }
+        return best;
+    };
+    TArgResult<Value> result = parallelReduceRange<TArgResult<Value> >(0, count, leaf, combine, grain, defaultForkDepth());
+    if (result.index == (size_t)-1) result.index = count;
+    return result;
+}
+
+// findLargestElement on the parallel reduction framework, same [left, right] contract
+int findLargestElementParallel(int arr[], int left, int right) {
+    return parallelReduce(arr + left, (size_t)(right - left + 1), std::numeric_limits<int>::min(),
+                          TIdentity<int>(), TMaxOp<int>());
+}
+
 // Recursively prints ASCII characters from start to end
 // Time: O(n), Space: O(n) due to call stack
 void traverseAsciiTable(char start, char end) {
@@ -99,11 +588,146 @@ int main() {
     std::cout << "findLargestElement(arr, 0, " << arrSize - 1 << "): ";
     std::cout << findLargestElement(arr, 0, arrSize - 1) << "\n";
     std::cout << findLargestElement(arr, 2, 4) << "\n";
+    std::cout << "findLargestElementParallel(arr, 0, " << arrSize - 1 << "): ";
+    std::cout << findLargestElementParallel(arr, 0, arrSize - 1) << "\n";
 
     std::cout << "traverseAsciiTable('A', 'E' and 'X', 'Z'): ";
     traverseAsciiTable('A', 'E');
     std::cout << "\n";
     traverseAsciiTable('X', 'Z');
+    std::cout << "\n";
+
+    // Iterative versions must print and count exactly like the recursive ones
+    std::ostringstream recursiveOut, iterativeOut;
+    std::streambuf* coutBuffer = std::cout.rdbuf(recursiveOut.rdbuf());
+    printNaturalNumbers(25);
+    traverseAsciiTable('A', 'Z');
+    traverseAsciiTable('Z', 'A');
+    std::cout.rdbuf(iterativeOut.rdbuf());
+    printNaturalNumbersIterative(25);
+    traverseAsciiTableIterative('A', 'Z');
+    traverseAsciiTableIterative('Z', 'A');
+    std::cout.rdbuf(coutBuffer);
+    bool sameOutput = recursiveOut.str() == iterativeOut.str()
+        && countOccurrences(testStr, testChar) == countOccurrencesIterative(testStr, testChar);
+    std::cout << "Iterative versions match recursive output: " << (sameOutput ? "yes" : "no") << "\n";
+
+    // Benchmark: a 100 MB input would overflow the recursive countOccurrences
+    const size_t largeSize = 100u * 1024u * 1024u;
+    long memoryBefore = peakMemoryKb();
+    std::string large(largeSize, 'a');
+    for (size_t i = 0; i < largeSize; i += 7) large[i] = 'o';
+    auto countStart = std::chrono::steady_clock::now();
+    int largeCount = countOccurrencesIterative(large, 'o');
+    auto countEnd = std::chrono::steady_clock::now();
+    std::cout << "countOccurrencesIterative on 100 MB: " << largeCount << " in "
+              << std::chrono::duration<double, std::milli>(countEnd - countStart).count() << " ms, peak memory "
+              << peakMemoryKb() / 1024 << " MB (" << memoryBefore / 1024 << " MB before input)\n";
+    large.clear();
+    large.shrink_to_fit();
+
+    // Benchmark: delimiter counting on a 1 GB buffer
+    {
+        const size_t bufferSize = 1024u * 1024u * 1024u;
+        std::string buffer(bufferSize, 'x');
+        for (size_t i = 0; i < bufferSize; i += 61) buffer[i] = ',';
+        for (size_t i = 0; i < bufferSize; i += 97) buffer[i] = '\n';
+        const std::string shortBuffer = buffer.substr(0, 10000);
+        std::cout << "\nCounting ',' in a 1 GB buffer (recursive version on the first 10 KB only):\n";
+        std::cout << "method\t\t\tcount\t\ttime(ms)\tGB/s\n";
+        auto report = [](const char* name, size_t count, std::chrono::steady_clock::duration elapsed, size_t bytes) {
+            double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+            std::cout << name << "\t" << count << "\t" << ms << "\t\t" << (bytes / 1e9) / (ms / 1000.0) << "\n";
+        };
+        auto t0 = std::chrono::steady_clock::now();
+        size_t recursiveCount = countOccurrences(shortBuffer, ',');
+        auto t1 = std::chrono::steady_clock::now();
+        report("recursive (10 KB)\t", recursiveCount, t1 - t0, shortBuffer.size());
+        t0 = std::chrono::steady_clock::now();
+        size_t stdCount = std::count(buffer.begin(), buffer.end(), ',');
+        t1 = std::chrono::steady_clock::now();
+        report("std::count\t\t", stdCount, t1 - t0, bufferSize);
+        t0 = std::chrono::steady_clock::now();
+        size_t simdCount = countOccurrencesSimd(buffer.data(), buffer.size(), ',');
+        t1 = std::chrono::steady_clock::now();
+        report("countOccurrencesSimd\t", simdCount, t1 - t0, bufferSize);
+        t0 = std::chrono::steady_clock::now();
+        size_t parallelCount = countOccurrencesParallel(buffer, ',');
+        t1 = std::chrono::steady_clock::now();
+        report("countOccurrencesParallel", parallelCount, t1 - t0, bufferSize);
+        t0 = std::chrono::steady_clock::now();
+        size_t setCount = countAnyOfSimd(buffer.data(), buffer.size(), ",\n");
+        t1 = std::chrono::steady_clock::now();
+        report("countAnyOfSimd(\",\\n\")\t", setCount, t1 - t0, bufferSize);
+        std::cout << "Counts agree: " << (stdCount == simdCount && simdCount == parallelCount ? "yes" : "no") << "\n";
+    }
+
+    // Parallel reduction over projected fields of account-like rows
+    {
+        struct TAccountRow { int id; double balance; };
+        const size_t rowCount = 4000000;
+        std::vector<TAccountRow> rows(rowCount);
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<> balanceDis(-50000.0, 1000.0);
+        for (size_t i = 0; i < rowCount; ++i) rows[i] = TAccountRow{(int)i, balanceDis(gen)};
+        auto balanceOf = [](const TAccountRow& row) { return row.balance; };
+
+        auto start = std::chrono::steady_clock::now();
+        double total = parallelReduce(rows.data(), rowCount, 0.0, balanceOf, TSumOp<double>());
+        double lowest = parallelReduce(rows.data(), rowCount, std::numeric_limits<double>::max(), balanceOf, TMinOp<double>());
+        TArgResult<double> richest = parallelArgMax<double>(rows.data(), rowCount, balanceOf);
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "\nparallelReduce over " << rowCount << " rows: sum " << total << ", min " << lowest
+                  << ", max " << richest.value << " (row " << rows[richest.index].id << ") in "
+                  << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+        std::vector<int> values(rowCount);
+        for (size_t i = 0; i < rowCount; ++i) values[i] = (int)(gen() % 1000000);
+        values[rowCount / 3] = 1000000;
+        start = std::chrono::steady_clock::now();
+        int serialMax = findLargestElement(values.data(), 0, (int)rowCount - 1);
+        auto mid = std::chrono::steady_clock::now();
+        int parallelMax = findLargestElementParallel(values.data(), 0, (int)rowCount - 1);
+        end = std::chrono::steady_clock::now();
+        std::cout << "findLargestElement " << serialMax << " in " << std::chrono::duration<double, std::milli>(mid - start).count()
+                  << " ms, findLargestElementParallel " << parallelMax << " in "
+                  << std::chrono::duration<double, std::milli>(end - mid).count() << " ms\n";
+    }
+
+    // Fast paths must agree with the reference kernels wherever those do not overflow
+    bool agree = true;
+    for (int n = 0; n <= 25; ++n) agree = agree && fastFibonacci(n) == TBigInt((uint64_t)fibonacci(n));
+    for (int n = 0; n <= 12; ++n) agree = agree && bigFactorial(n) == TBigInt((uint64_t)calculateFactorial(n));
+    for (int e = 0; e <= 19; ++e) agree = agree && bigPower(3, e) == TBigInt((uint64_t)power(3, e));
+    std::cout << "Fast paths agree with recursive kernels: " << (agree ? "yes" : "no") << "\n";
+    std::cout << "fastFibonacci(100): " << fastFibonacci(100).ToString() << "\n";
+    std::cout << "bigFactorial(25): " << bigFactorial(25).ToString() << "\n";
+    std::cout << "bigPower(2, 100): " << bigPower(2, 100).ToString() << "\n";
+
+    // Benchmark: naive recursion against fast doubling, then big results up to n = 100000
+    std::cout << "\nn\tfibonacci(ms)\tfastFibonacci(ms)\n";
+    for (int n = 20; n <= 35; n += 5) {
+        auto start = std::chrono::steady_clock::now();
+        volatile int naive = fibonacci(n);
+        auto mid = std::chrono::steady_clock::now();
+        TBigInt fast = fastFibonacci(n);
+        auto end = std::chrono::steady_clock::now();
+        (void)naive;
+        std::cout << n << "\t" << std::chrono::duration<double, std::milli>(mid - start).count()
+                  << "\t\t" << std::chrono::duration<double, std::milli>(end - mid).count() << "\n";
+    }
+    std::cout << "\nn\tfastFibonacci(ms)\tdigits\tbigFactorial(ms)\tdigits\n";
+    for (int n = 1000; n <= 100000; n *= 10) {
+        auto start = std::chrono::steady_clock::now();
+        TBigInt fib = fastFibonacci(n);
+        auto mid = std::chrono::steady_clock::now();
+        TBigInt fact = bigFactorial(n);
+        auto end = std::chrono::steady_clock::now();
+        std::cout << n << "\t" << std::chrono::duration<double, std::milli>(mid - start).count()
+                  << "\t\t\t" << fib.DigitCount()
+                  << "\t" << std::chrono::duration<double, std::milli>(end - mid).count()
+                  << "\t\t" << fact.DigitCount() << "\n";
+    }
 
     return 0;
 }
@@ -12,60 +12,792 @@
 #include <sstream>
 #include <iomanip>
 #include <map>
+#include <cstdint>
+#include <thread>
+#include <algorithm>
+#include <shared_mutex>
+#include <cctype>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstdio>
+#include <filesystem>
+#include <charconv>
+#include <cstring>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <cstdlib>
+#include <new>
+
+// Memory mapping for the binary account file; other platforms read the file into memory instead
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ACCOUNT_FILE_HAS_MMAP 1
+#endif
+
+// Hardware performance counters for the measured scopes; other platforms report them as unavailable
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PERF_COUNTERS_HAS_PERF_EVENT 1
+#endif
 
 enum class EBankAccountType { Checking, Savings, Credit, Pension, Loan };
 
 // Forward declaration for TBankAccount
 class TBankAccount;
 
+// Hardware counter deltas for one measured scope; -1 when a counter is unavailable (counters
+// disabled, non-Linux build, or perf_event_open refused by the kernel or hypervisor)
+struct PerfCounters {
+    long long cycles;
+    long long instructions;
+    long long cacheMisses;
+    long long branchMisses;
+
+    PerfCounters() : cycles(-1), instructions(-1), cacheMisses(-1), branchMisses(-1) {}
+};
+
 // SearchSummary struct to hold performance data
 struct SearchSummary {
     long long comparisons;  // Number of comparisons performed
     double timeSpentMs;     // Time spent in milliseconds
+    long long timeSpentNs;  // Time spent in nanoseconds (steady_clock)
+    long long bytesAllocated; // Bytes requested from operator new on the searching thread
+    PerfCounters counters;  // Hardware counters, when enabled
     
-    SearchSummary() : comparisons(0), timeSpentMs(0.0) {}
+    SearchSummary() : comparisons(0), timeSpentMs(0.0), timeSpentNs(0), bytesAllocated(0) {}
 };
 
 // Typedef for callback function pointer
 typedef bool (*FCompareAccount)(TBankAccount* account, void* searchKey);
 
+// Bytes requested from operator new on the current thread since it started. Counted always, at
+// one thread-local add per allocation. Every plain/array/nothrow form is replaced so each
+// allocation is counted and paired with the matching delete; aligned forms are left to the library.
+thread_local long long threadBytesAllocated = 0;
+
+// Allocation and release are kept out of line: if GCC inlines free() into a replaced operator
+// delete it pairs it with operator new and reports -Wmismatched-new-delete at every call site
+#if defined(__GNUC__)
+#define ALLOCATION_NOINLINE __attribute__((noinline))
+#else
+#define ALLOCATION_NOINLINE
+#endif
+
+ALLOCATION_NOINLINE void* CountedAllocate(std::size_t size) noexcept {
+    void* memory = std::malloc(size ? size : 1);
+    if (memory) threadBytesAllocated += (long long)size;
+    return memory;
+}
+
+ALLOCATION_NOINLINE void CountedFree(void* memory) noexcept { std::free(memory); }
+
+// Retries through the installed new_handler before giving up, as the standard operator new does
+void* operator new(std::size_t size) {
+    for (;;) {
+        if (void* memory = CountedAllocate(size)) return memory;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return operator new(size); } catch (const std::bad_alloc&) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return operator new(size); } catch (const std::bad_alloc&) { return nullptr; }
+}
+void operator delete(void* memory) noexcept { CountedFree(memory); }
+void operator delete[](void* memory) noexcept { CountedFree(memory); }
+void operator delete(void* memory, std::size_t) noexcept { CountedFree(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { CountedFree(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { CountedFree(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { CountedFree(memory); }
+
+// Hardware counters are off by default (--counters turns them on): each measured scope then
+// costs two read() system calls
+std::atomic<bool>& PerfCountersFlag() {
+    static std::atomic<bool> enabled(false);
+    return enabled;
+}
+
+bool PerfCountersEnabled() { return PerfCountersFlag().load(std::memory_order_relaxed); }
+void SetPerfCountersEnabled(bool enabled) { PerfCountersFlag().store(enabled, std::memory_order_relaxed); }
+
+// One perf_event group per thread (cycles leads; instructions, cache misses and branch misses
+// follow), opened on first use and left running; scopes take deltas of group reads, so they nest.
+// User-space only, which unprivileged processes are allowed to count.
+class TPerfCounterGroup {
+private:
+    static const int COUNTER_COUNT = 4;
+    int fds[COUNTER_COUNT];
+    int slots[COUNTER_COUNT]; // Position of each counter in a group read, -1 if it did not open
+    int openCount;
+
+public:
+    TPerfCounterGroup() : openCount(0) {
+        for (int i = 0; i < COUNTER_COUNT; i++) { fds[i] = -1; slots[i] = -1; }
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+        const uint64_t configs[COUNTER_COUNT] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                  PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+        for (int i = 0; i < COUNTER_COUNT; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.read_format = PERF_FORMAT_GROUP;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            int leader = openCount == 0 ? -1 : fds[0];
+            int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+            if (fd < 0) {
+                if (i == 0) return; // Without cycles there is no group to read
+                continue;
+            }
+            fds[i] = fd;
+            slots[i] = openCount++;
+        }
+#endif
+    }
+
+    ~TPerfCounterGroup() {
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+        for (int i = 0; i < COUNTER_COUNT; i++) if (fds[i] >= 0) close(fds[i]);
+#endif
+    }
+
+    TPerfCounterGroup(const TPerfCounterGroup&) = delete;
+    TPerfCounterGroup& operator=(const TPerfCounterGroup&) = delete;
+
+    static TPerfCounterGroup& ForThisThread() {
+        thread_local TPerfCounterGroup group;
+        return group;
+    }
+
+    // Current running totals, -1 for counters that did not open; false if nothing could be read
+    bool Read(long long values[COUNTER_COUNT]) const {
+        for (int i = 0; i < COUNTER_COUNT; i++) values[i] = -1;
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+        if (openCount == 0) return false;
+        uint64_t buffer[1 + COUNTER_COUNT];
+        if (read(fds[0], buffer, sizeof(buffer)) < (ssize_t)((1 + openCount) * sizeof(uint64_t))) return false;
+        for (int i = 0; i < COUNTER_COUNT; i++) if (slots[i] >= 0) values[i] = (long long)buffer[1 + slots[i]];
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+// Measures the enclosing scope into a summary: steady_clock nanoseconds (and timeSpentMs from
+// them), bytes allocated on this thread and, when enabled, hardware counter deltas. Results are
+// written by Stop() or the destructor, so early returns are measured too.
+template<typename Summary>
+class TPerfScope {
+private:
+    Summary& summary;
+    bool counting;
+    bool stopped;
+    long long startBytes;
+    long long startCounters[4];
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit TPerfScope(Summary& target)
+        : summary(target), counting(PerfCountersEnabled()), stopped(false), startBytes(threadBytesAllocated) {
+        if (counting) counting = TPerfCounterGroup::ForThisThread().Read(startCounters);
+        start = std::chrono::steady_clock::now(); // Last, so the counter read is not timed
+    }
+
+    ~TPerfScope() { Stop(); }
+
+    TPerfScope(const TPerfScope&) = delete;
+    TPerfScope& operator=(const TPerfScope&) = delete;
+
+    void Stop() {
+        if (stopped) return;
+        stopped = true;
+        auto end = std::chrono::steady_clock::now();
+        summary.timeSpentNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        summary.timeSpentMs = summary.timeSpentNs / 1e6;
+        if (counting) {
+            long long endCounters[4];
+            TPerfCounterGroup::ForThisThread().Read(endCounters);
+            long long* fields[4] = { &summary.counters.cycles, &summary.counters.instructions,
+                                     &summary.counters.cacheMisses, &summary.counters.branchMisses };
+            for (int i = 0; i < 4; i++) {
+                *fields[i] = (startCounters[i] < 0 || endCounters[i] < 0) ? -1 : endCounters[i] - startCounters[i];
+            }
+        }
+        summary.bytesAllocated = threadBytesAllocated - startBytes;
+    }
+};
+
+// "cycles=... instructions=... (IPC ...) cache-misses=... branch-misses=..." with n/a for
+// counters that were not measured
+std::string FormatPerfCounters(const PerfCounters& counters) {
+    auto field = [](long long value) { return value < 0 ? std::string("n/a") : std::to_string(value); };
+    std::ostringstream out;
+    out << "cycles=" << field(counters.cycles) << " instructions=" << field(counters.instructions);
+    if (counters.cycles > 0 && counters.instructions >= 0) {
+        out << " (IPC " << std::fixed << std::setprecision(2) << (double)counters.instructions / counters.cycles << ")";
+    }
+    out << " cache-misses=" << field(counters.cacheMisses) << " branch-misses=" << field(counters.branchMisses);
+    return out.str();
+}
+
+// Scoped tracing. A TTraceScope records one complete event (name, start, duration, nesting
+// depth) into a ring buffer owned by the current thread when it closes. While tracing is off
+// a scope costs one relaxed atomic load. Turn it on with SetTracingEnabled(true), or --trace /
+// --trace-folded on the command line, and export with WriteChromeTrace (chrome://tracing,
+// Perfetto) or WriteFoldedStacks (flamegraph.pl, speedscope).
+// Names must be string literals; only the pointer is stored.
+const size_t TRACE_RING_EVENTS = 1 << 16; // Per thread; the oldest events are overwritten
+
+struct TTraceEvent {
+    const char* name;
+    uint64_t startNs;    // Since the first traced event in the process
+    uint64_t durationNs;
+    uint32_t depth;      // Enclosing open scopes on the same thread
+};
+
+// Events of one thread. Only the owning thread writes; written is published with release so an
+// exporter running after the traced work has finished sees complete events.
+struct TTraceBuffer {
+    uint32_t threadId;
+    std::vector<TTraceEvent> ring;
+    std::atomic<uint64_t> written;
+
+    explicit TTraceBuffer(uint32_t id) : threadId(id), ring(TRACE_RING_EVENTS), written(0) {}
+};
+
+std::atomic<bool> tracingEnabled(false);
+
+bool TracingEnabled() { return tracingEnabled.load(std::memory_order_relaxed); }
+void SetTracingEnabled(bool enabled) { tracingEnabled.store(enabled, std::memory_order_relaxed); }
+
+// Every thread's buffer, kept alive after the thread exits so its events can still be exported
+class TTraceRegistry {
+private:
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TTraceBuffer>> buffers;
+    std::chrono::steady_clock::time_point epoch;
+
+public:
+    TTraceRegistry() : epoch(std::chrono::steady_clock::now()) {}
+
+    static TTraceRegistry& Instance() {
+        static TTraceRegistry registry;
+        return registry;
+    }
+
+    uint64_t NowNs() const {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    TTraceBuffer& ThreadBuffer() {
+        thread_local std::shared_ptr<TTraceBuffer> buffer;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffer = std::make_shared<TTraceBuffer>((uint32_t)buffers.size() + 1);
+            buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    // Snapshot of each thread's surviving events in recording order
+    std::vector<std::pair<uint32_t, std::vector<TTraceEvent>>> Snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::pair<uint32_t, std::vector<TTraceEvent>>> threads;
+        for (const auto& buffer : buffers) {
+            uint64_t written = buffer->written.load(std::memory_order_acquire);
+            uint64_t first = written > TRACE_RING_EVENTS ? written - TRACE_RING_EVENTS : 0;
+            std::vector<TTraceEvent> events;
+            events.reserve((size_t)(written - first));
+            for (uint64_t i = first; i < written; i++) events.push_back(buffer->ring[i % TRACE_RING_EVENTS]);
+            threads.emplace_back(buffer->threadId, std::move(events));
+        }
+        return threads;
+    }
+};
+
+thread_local uint32_t traceDepth = 0;
+
+class TTraceScope {
+private:
+    const char* name; // nullptr when tracing was off as the scope opened
+    uint64_t startNs;
+
+public:
+    explicit TTraceScope(const char* scopeName) : name(nullptr), startNs(0) {
+        if (!TracingEnabled()) return;
+        name = scopeName;
+        traceDepth++;
+        startNs = TTraceRegistry::Instance().NowNs();
+    }
+
+    ~TTraceScope() {
+        if (!name) return;
+        TTraceRegistry& registry = TTraceRegistry::Instance();
+        uint64_t endNs = registry.NowNs();
+        traceDepth--;
+        TTraceBuffer& buffer = registry.ThreadBuffer();
+        uint64_t index = buffer.written.load(std::memory_order_relaxed);
+        buffer.ring[index % TRACE_RING_EVENTS] = TTraceEvent{ name, startNs, endNs - startNs, traceDepth };
+        buffer.written.store(index + 1, std::memory_order_release);
+    }
+
+    TTraceScope(const TTraceScope&) = delete;
+    TTraceScope& operator=(const TTraceScope&) = delete;
+};
+
+// Chrome trace-event JSON: one complete ("X") event per scope, timestamps in microseconds
+void WriteChromeTrace(std::ostream& out) {
+    auto threads = TTraceRegistry::Instance().Snapshot();
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    for (const auto& thread : threads) {
+        for (const TTraceEvent& event : thread.second) {
+            out << (first ? "\n" : ",\n") << "  {\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                << thread.first << std::fixed << std::setprecision(3) << ", \"ts\": " << event.startNs / 1000.0
+                << ", \"dur\": " << event.durationNs / 1000.0 << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+}
+
+// Folded stacks ("outer;inner nanoseconds" per line) with self time, so a flame graph's widths
+// add up to the traced time. Stacks are rebuilt per thread from start times and depths; a scope
+// whose parent was overwritten in the ring becomes a root.
+void WriteFoldedStacks(std::ostream& out) {
+    std::map<std::string, uint64_t> selfNs;
+    for (auto& thread : TTraceRegistry::Instance().Snapshot()) {
+        std::vector<TTraceEvent>& events = thread.second;
+        // Events are recorded as scopes close (children first); order them parent first
+        std::sort(events.begin(), events.end(), [](const TTraceEvent& a, const TTraceEvent& b) {
+            return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth;
+        });
+        std::vector<std::string> paths(events.size());
+        std::vector<uint64_t> selfTime(events.size());
+        std::vector<size_t> open; // Indices of the scopes enclosing the current event
+        for (size_t i = 0; i < events.size(); i++) {
+            const TTraceEvent& event = events[i];
+            while (!open.empty() && (events[open.back()].depth >= event.depth ||
+                                     events[open.back()].startNs + events[open.back()].durationNs <= event.startNs)) {
+                open.pop_back();
+            }
+            paths[i] = open.empty() ? std::string(event.name) : paths[open.back()] + ";" + event.name;
+            selfTime[i] = event.durationNs;
+            if (!open.empty()) {
+                uint64_t& parentSelf = selfTime[open.back()];
+                parentSelf -= std::min(parentSelf, event.durationNs);
+            }
+            open.push_back(i);
+        }
+        for (size_t i = 0; i < events.size(); i++) selfNs[paths[i]] += selfTime[i];
+    }
+    for (const auto& entry : selfNs) {
+        if (entry.second > 0) out << entry.first << " " << entry.second << "\n";
+    }
+}
+
+// Writes the requested trace files; an empty path skips that format
+bool WriteTraceFiles(const std::string& chromePath, const std::string& foldedPath) {
+    bool ok = true;
+    if (!chromePath.empty()) {
+        std::ofstream file(chromePath);
+        if (file) WriteChromeTrace(file);
+        ok = ok && (bool)file;
+    }
+    if (!foldedPath.empty()) {
+        std::ofstream file(foldedPath);
+        if (file) WriteFoldedStacks(file);
+        ok = ok && (bool)file;
+    }
+    if (!ok) std::cerr << "Could not write trace output" << std::endl;
+    return ok;
+}
+
+// xoshiro256** generator: 32 bytes of state and a handful of shifts per draw, so it can be
+// passed around and copied per thread instead of reseeding a std::mt19937 for every account.
+// Satisfies UniformRandomBitGenerator, so the std distributions accept it as well.
+class TXoshiro256 {
+private:
+    uint64_t state[4];
+
+    static uint64_t RotateLeft(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    typedef uint64_t result_type;
+
+    explicit TXoshiro256(uint64_t seed = 0) { Seed(seed); }
+
+    // Expands a 64-bit seed into the full state so similar seeds still give unrelated streams
+    void Seed(uint64_t seed) {
+        for (int i = 0; i < 4; i++) state[i] = SplitMix64(seed);
+    }
+
+    // splitmix64 step: advances x and returns a well-mixed 64-bit value
+    static uint64_t SplitMix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = RotateLeft(state[3], 45);
+        return result;
+    }
+
+    // Uniform integer in [0, bound) by multiply-shift instead of a modulo
+    uint32_t NextBelow(uint32_t bound) {
+        return (uint32_t)(((*this)() >> 32) * bound >> 32);
+    }
+
+    // Uniform double in [low, high) from the top 53 bits
+    double NextDouble(double low, double high) {
+        return low + (high - low) * ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+// Per-thread generator for callers that do not pass one; seeded once from random_device
+TXoshiro256& ThreadLocalGenerator() {
+    thread_local TXoshiro256 gen(((uint64_t)std::random_device{}() << 32) ^ std::random_device{}());
+    return gen;
+}
+
+// Random opening balance for an account type (loans and credit start negative)
+double GenerateBalance(EBankAccountType accountType, TXoshiro256& gen) {
+    switch (accountType) {
+        case EBankAccountType::Loan:     return gen.NextDouble(-50000.0, -25000.0);
+        case EBankAccountType::Credit:   return gen.NextDouble(-1000.0, 0.0);
+        case EBankAccountType::Checking:
+        case EBankAccountType::Savings:
+        case EBankAccountType::Pension:  return gen.NextDouble(0.0, 1000.0);
+    }
+    return 0.0;
+}
+
+// Interns owner names to 32-bit ids so accounts store two ids instead of two strings.
+// Ids are handed out in string order with gaps left between neighbours, so comparing two ordered
+// ids gives the same answer as comparing the names. A name interned later takes the midpoint of
+// the gap around it; if that gap is used up it gets an id with UNORDERED_BIT set and comparisons
+// involving it fall back to the strings. Equal names always share one id. Thread-safe.
+class TNameDictionary {
+private:
+    mutable std::shared_mutex mutex;
+    std::map<std::string, uint32_t, std::less<>> idsByName; // Sorted, so neighbours are one step away
+    std::unordered_map<uint32_t, const std::string*> namesById; // Points at the map's keys
+    uint32_t nextUnorderedId;
+
+    // Nearest ordered id on each side of position; 0 and UNORDERED_BIT bound the range
+    uint32_t OrderedIdBefore(std::map<std::string, uint32_t, std::less<>>::const_iterator position) const {
+        while (position != idsByName.begin()) {
+            --position;
+            if (IsOrdered(position->second)) return position->second;
+        }
+        return 0;
+    }
+
+    uint32_t OrderedIdFrom(std::map<std::string, uint32_t, std::less<>>::const_iterator position) const {
+        for (; position != idsByName.end(); ++position) {
+            if (IsOrdered(position->second)) return position->second;
+        }
+        return UNORDERED_BIT;
+    }
+
+    uint32_t Insert(std::string_view name, uint32_t id) {
+        auto inserted = idsByName.emplace(std::string(name), id).first;
+        namesById.emplace(id, &inserted->first);
+        return id;
+    }
+
+public:
+    static constexpr uint32_t INVALID_ID = 0;
+    static constexpr uint32_t UNORDERED_BIT = 0x80000000u;
+
+    // Spreads the distinct catalogue names evenly over the ordered id range
+    explicit TNameDictionary(const std::vector<std::string>& catalogue = {}) : nextUnorderedId(1) {
+        std::vector<std::string> sorted(catalogue);
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        uint32_t spacing = (uint32_t)((UNORDERED_BIT - 1) / (sorted.size() + 1));
+        for (size_t i = 0; i < sorted.size(); i++) Insert(sorted[i], (uint32_t)(spacing * (i + 1)));
+    }
+
+    TNameDictionary(const TNameDictionary&) = delete;
+    TNameDictionary& operator=(const TNameDictionary&) = delete;
+
+    static bool IsOrdered(uint32_t id) { return (id & UNORDERED_BIT) == 0; }
+
+    // Returns the id of name, adding it if needed
+    // Time: O(log n) string comparisons, Space: O(1) per new name
+    uint32_t Intern(std::string_view name) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = idsByName.find(name);
+            if (it != idsByName.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto position = idsByName.lower_bound(name);
+        if (position != idsByName.end() && position->first == name) return position->second; // Raced with another Intern
+        uint32_t low = OrderedIdBefore(position);
+        uint32_t high = OrderedIdFrom(position);
+        if (high - low > 1) return Insert(name, low + (high - low) / 2);
+        return Insert(name, UNORDERED_BIT | nextUnorderedId++);
+    }
+
+    // Looks name up without adding it; returns false if it was never interned
+    bool Find(std::string_view name, uint32_t& id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = idsByName.find(name);
+        if (it == idsByName.end()) return false;
+        id = it->second;
+        return true;
+    }
+
+    // Name for an interned id; throws std::out_of_range for unknown ids
+    const std::string& Name(uint32_t id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = namesById.find(id);
+        if (it == namesById.end()) throw std::out_of_range("Unknown name id");
+        return *it->second;
+    }
+
+    // Negative, zero or positive like std::string::compare; integer-only when both ids are ordered
+    // Time: O(1) for ordered ids, Space: O(1)
+    int Compare(uint32_t a, uint32_t b) const {
+        if (a == b) return 0;
+        if (IsOrdered(a) && IsOrdered(b)) return a < b ? -1 : 1;
+        return Name(a).compare(Name(b));
+    }
+
+    size_t Size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return idsByName.size();
+    }
+};
+
+// Dictionary shared by every TBankAccount; seeded with the firstNames/lastNames catalogue
+TNameDictionary& NameDictionary();
+
+// Registry of account number prefixes ("ACC", ...) so a packed number stores a small id, not text
+class TAccountPrefixTable {
+private:
+    mutable std::shared_mutex mutex;
+    std::deque<std::string> prefixes; // deque keeps references valid as prefixes are added
+
+public:
+    static constexpr uint32_t MAX_PREFIXES = 4096; // Ids must fit in 12 bits
+
+    TAccountPrefixTable() { prefixes.emplace_back("ACC"); } // ACC_PREFIX_ID
+
+    // Returns false if prefix is new and the table is full
+    bool Intern(std::string_view prefix, uint32_t& id) {
+        if (Find(prefix, id)) return true;
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        for (size_t i = 0; i < prefixes.size(); i++) {
+            if (prefixes[i] == prefix) { id = (uint32_t)i; return true; } // Raced with another Intern
+        }
+        if (prefixes.size() == MAX_PREFIXES) return false;
+        id = (uint32_t)prefixes.size();
+        prefixes.emplace_back(prefix);
+        return true;
+    }
+
+    // Looks prefix up without adding it (a handful of prefixes, so a linear scan)
+    bool Find(std::string_view prefix, uint32_t& id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        for (size_t i = 0; i < prefixes.size(); i++) {
+            if (prefixes[i] == prefix) { id = (uint32_t)i; return true; }
+        }
+        return false;
+    }
+
+    const std::string& Prefix(uint32_t id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        if (id >= prefixes.size()) throw std::out_of_range("Unknown account number prefix id");
+        return prefixes[id];
+    }
+};
+
+// Prefix table shared by every account number
+TAccountPrefixTable& AccountPrefixes() {
+    static TAccountPrefixTable table;
+    return table;
+}
+
+const uint32_t ACC_PREFIX_ID = 0; // "ACC", registered when the table is created
+
+// Account number such as "ACC123456" packed into 64 bits:
+// prefix id (12 bits) | digit count (4 bits) | numeric part (48 bits).
+// The digit count keeps leading zeros, so "ACC003" and "ACC3" stay different numbers.
+// Equality, hashing and ordering work on Key() alone; text only appears at the I/O boundary
+// through Parse/Lookup and ToString. Keys order by prefix id, then length, then value.
+class TAccountNumber {
+private:
+    uint64_t packed;
+
+    static constexpr int NUMBER_BITS = 48;
+    static constexpr int DIGIT_BITS = 4;
+    static constexpr uint64_t NUMBER_MASK = (1ULL << NUMBER_BITS) - 1;
+
+    // Splits text into a letter prefix and 1..MAX_DIGITS digits
+    static bool Split(std::string_view text, std::string_view& prefix, uint64_t& number, uint32_t& digits) {
+        size_t firstDigit = 0;
+        while (firstDigit < text.size() && !std::isdigit((unsigned char)text[firstDigit])) firstDigit++;
+        digits = (uint32_t)(text.size() - firstDigit);
+        if (digits == 0 || digits > MAX_DIGITS) return false;
+        number = 0;
+        for (size_t i = firstDigit; i < text.size(); i++) {
+            if (!std::isdigit((unsigned char)text[i])) return false;
+            number = number * 10 + (uint64_t)(text[i] - '0');
+        }
+        prefix = text.substr(0, firstDigit);
+        return true;
+    }
+
+public:
+    static constexpr uint32_t MAX_DIGITS = 14; // 10^14 - 1 still fits in 48 bits
+
+    TAccountNumber() : packed(0) {}
+    TAccountNumber(uint32_t prefixId, uint32_t digits, uint64_t number)
+        : packed((uint64_t)prefixId << (NUMBER_BITS + DIGIT_BITS) | (uint64_t)digits << NUMBER_BITS | (number & NUMBER_MASK)) {}
+
+    // Implicit from text so existing call sites keep passing strings; throws std::invalid_argument
+    // for text that is not a prefix followed by 1..MAX_DIGITS digits
+    TAccountNumber(std::string_view text) : packed(0) {
+        if (!Parse(text, *this)) throw std::invalid_argument("Invalid account number: " + std::string(text));
+    }
+    TAccountNumber(const std::string& text) : TAccountNumber(std::string_view(text)) {}
+    TAccountNumber(const char* text) : TAccountNumber(std::string_view(text)) {}
+
+    // Parses text, registering its prefix if new; returns false for malformed text
+    static bool Parse(std::string_view text, TAccountNumber& out) {
+        std::string_view prefix;
+        uint64_t number;
+        uint32_t digits, prefixId;
+        if (!Split(text, prefix, number, digits)) return false;
+        if (prefix == "ACC") prefixId = ACC_PREFIX_ID; // Common case, skips the table lock
+        else if (!AccountPrefixes().Intern(prefix, prefixId)) return false;
+        out = TAccountNumber(prefixId, digits, number);
+        return true;
+    }
+
+    // Parses a search key without registering anything; false also means no account can match
+    static bool Lookup(std::string_view text, TAccountNumber& out) {
+        std::string_view prefix;
+        uint64_t number;
+        uint32_t digits, prefixId;
+        if (!Split(text, prefix, number, digits)) return false;
+        if (prefix == "ACC") prefixId = ACC_PREFIX_ID; // Common case, skips the table lock
+        else if (!AccountPrefixes().Find(prefix, prefixId)) return false;
+        out = TAccountNumber(prefixId, digits, number);
+        return true;
+    }
+
+    uint64_t Key() const { return packed; }
+    uint32_t PrefixId() const { return (uint32_t)(packed >> (NUMBER_BITS + DIGIT_BITS)); }
+    uint32_t Digits() const { return (uint32_t)(packed >> NUMBER_BITS) & ((1u << DIGIT_BITS) - 1); }
+    uint64_t Number() const { return packed & NUMBER_MASK; }
+
+    std::string ToString() const {
+        std::string digits = std::to_string(Number());
+        if (digits.size() < Digits()) digits.insert(0, Digits() - digits.size(), '0');
+        return AccountPrefixes().Prefix(PrefixId()) + digits;
+    }
+
+    bool operator==(const TAccountNumber& other) const { return packed == other.packed; }
+    bool operator!=(const TAccountNumber& other) const { return packed != other.packed; }
+    bool operator<(const TAccountNumber& other) const { return packed < other.packed; }
+};
+
+std::ostream& operator<<(std::ostream& out, const TAccountNumber& accountNumber) {
+    return out << accountNumber.ToString();
+}
+
+// Hash functor for unordered containers keyed by account number
+struct TAccountNumberHash {
+    size_t operator()(const TAccountNumber& accountNumber) const { return std::hash<uint64_t>()(accountNumber.Key()); }
+};
+
 class TBankAccount {
 public:
-    std::string accountNumber;
+    TAccountNumber accountNumber;   // Packed; strings convert implicitly
     EBankAccountType accountType;
-    std::string ownerFirstName;
-    std::string ownerLastName;
+    uint32_t ownerFirstNameId;  // Id in NameDictionary()
+    uint32_t ownerLastNameId;   // Id in NameDictionary()
     time_t creationTimestamp;
     double balance;
 
-    TBankAccount(const std::string& accountNumber,
+    TBankAccount(TAccountNumber accountNumber,
                  EBankAccountType accountType,
                  const std::string& ownerFirstName,
                  const std::string& ownerLastName,
                  time_t creationTimestamp)
         : accountNumber(accountNumber),
           accountType(accountType),
-          ownerFirstName(ownerFirstName),
-          ownerLastName(ownerLastName),
-          creationTimestamp(creationTimestamp)
-    {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        if (accountType == EBankAccountType::Loan) {
-            std::uniform_real_distribution<> dis(-50000.0, -25000.0);
-            balance = dis(gen);
-        } else if (accountType == EBankAccountType::Credit) {
-            std::uniform_real_distribution<> dis(-1000.0, 0.0);
-            balance = dis(gen);
-        } else if (accountType == EBankAccountType::Checking ||
-                   accountType == EBankAccountType::Savings ||
-                   accountType == EBankAccountType::Pension) {
-            std::uniform_real_distribution<> dis(0.0, 1000.0);
-            balance = dis(gen);
-        } else {
-            balance = 0.0;
-        }
-    }
+          ownerFirstNameId(NameDictionary().Intern(ownerFirstName)),
+          ownerLastNameId(NameDictionary().Intern(ownerLastName)),
+          creationTimestamp(creationTimestamp),
+          balance(GenerateBalance(accountType, ThreadLocalGenerator())) {}
+
+    // Draws the balance from the caller's generator so seeded runs are reproducible
+    TBankAccount(TAccountNumber accountNumber,
+                 EBankAccountType accountType,
+                 const std::string& ownerFirstName,
+                 const std::string& ownerLastName,
+                 time_t creationTimestamp,
+                 TXoshiro256& gen)
+        : accountNumber(accountNumber),
+          accountType(accountType),
+          ownerFirstNameId(NameDictionary().Intern(ownerFirstName)),
+          ownerLastNameId(NameDictionary().Intern(ownerLastName)),
+          creationTimestamp(creationTimestamp),
+          balance(GenerateBalance(accountType, gen)) {}
+
+    // Uses a known balance, e.g. when materialising a stored account
+    TBankAccount(TAccountNumber accountNumber,
+                 EBankAccountType accountType,
+                 const std::string& ownerFirstName,
+                 const std::string& ownerLastName,
+                 time_t creationTimestamp,
+                 double balance)
+        : accountNumber(accountNumber),
+          accountType(accountType),
+          ownerFirstNameId(NameDictionary().Intern(ownerFirstName)),
+          ownerLastNameId(NameDictionary().Intern(ownerLastName)),
+          creationTimestamp(creationTimestamp),
+          balance(balance) {}
+
+    const std::string& OwnerFirstName() const { return NameDictionary().Name(ownerFirstNameId); }
+    const std::string& OwnerLastName() const { return NameDictionary().Name(ownerLastNameId); }
 };
 
 // FINAL REPORT - DESIGN DECISION JUSTIFICATION:
@@ -176,12 +908,10 @@ public:
     
     // Find method using callback function with performance tracking
     TBankAccount* Find(FCompareAccount aOnCompare, void* searchKey, SearchSummary& summary) {
-        // Reset summary
-        summary.comparisons = 0;
-        summary.timeSpentMs = 0.0;
-        
-        // Start timing
-        auto start = std::chrono::high_resolution_clock::now();
+        // Reset summary; the scope fills in time, allocations and counters on either return
+        summary = SearchSummary();
+        TTraceScope trace("TLinkedList::Find");
+        TPerfScope<SearchSummary> scope(summary);
         
         Node* current = head;
         while (current != nullptr) {
@@ -190,21 +920,11 @@ public:
             // Cast to TBankAccount* for the callback
             TBankAccount* account = static_cast<TBankAccount*>(current->data);
             if (aOnCompare(account, searchKey)) {
-                // End timing
-                auto end = std::chrono::high_resolution_clock::now();
-                auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-                summary.timeSpentMs = duration.count() / 1000.0; // Convert to milliseconds
-                
                 return account;
             }
             current = current->next;
         }
         
-        // End timing (no match found)
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        summary.timeSpentMs = duration.count() / 1000.0; // Convert to milliseconds
-        
         return nullptr;
     }
     
@@ -219,12 +939,10 @@ public:
     
     // Every method to find all matching elements
     TLinkedList* Every(FCompareAccount aOnCompare, void* searchKey, SearchSummary& summary) {
-        // Reset summary
-        summary.comparisons = 0;
-        summary.timeSpentMs = 0.0;
-        
-        // Start timing
-        auto start = std::chrono::high_resolution_clock::now();
+        // Reset summary and start measuring
+        summary = SearchSummary();
+        TTraceScope trace("TLinkedList::Every");
+        TPerfScope<SearchSummary> scope(summary);
         
         // Create new list with ownsData = false to prevent double-deletion
         TLinkedList* resultList = new TLinkedList(false);
@@ -241,11 +959,6 @@ public:
             current = current->next;
         }
         
-        // End timing
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        summary.timeSpentMs = duration.count() / 1000.0; // Convert to milliseconds
-        
         return resultList;
     }
     
@@ -335,45 +1048,820 @@ std::vector<std::string> lastNames = {
     "Foster", "Ferguson", "Freeman", "Fletcher", "Franklin", "Fuller", "Francis", "Fowler"
 };
 
-// Generate random account number
-std::string GenerateAccountNumber(std::mt19937& gen) {
+TNameDictionary& NameDictionary() {
+    static TNameDictionary dictionary([] {
+        std::vector<std::string> catalogue(firstNames);
+        catalogue.insert(catalogue.end(), lastNames.begin(), lastNames.end());
+        return catalogue;
+    }());
+    return dictionary;
+}
+
+// Seed used for the generated data set; fixed so runs are reproducible
+const uint64_t DEFAULT_SEED = 20241003;
+
+// First and last second of a calendar year in local time
+struct TYearBounds {
+    time_t start;
+    time_t end;
+};
+
+TYearBounds ComputeYearBounds(int year) {
+    // January 1, 00:00:00
+    struct tm tmStart = {};
+    tmStart.tm_year = year - 1900;
+    tmStart.tm_mon = 0;
+    tmStart.tm_mday = 1;
+    tmStart.tm_isdst = -1;
+
+    // December 31, 23:59:59
+    struct tm tmEnd = {};
+    tmEnd.tm_year = year - 1900;
+    tmEnd.tm_mon = 11;
+    tmEnd.tm_mday = 31;
+    tmEnd.tm_hour = 23;
+    tmEnd.tm_min = 59;
+    tmEnd.tm_sec = 59;
+    tmEnd.tm_isdst = -1;
+
+    TYearBounds bounds;
+    bounds.start = mktime(&tmStart);
+    bounds.end = mktime(&tmEnd);
+    return bounds;
+}
+
+// 2024 bounds, computed on first use instead of two mktime calls per timestamp
+const TYearBounds& YearBounds2024() {
+    static const TYearBounds bounds = ComputeYearBounds(2024);
+    return bounds;
+}
+
+// Generate random account number ("ACC" + six digits), packed directly without any text
+template<typename Generator>
+TAccountNumber GenerateAccountNumber(Generator& gen) {
     std::uniform_int_distribution<> dis(100000, 999999);
-    return "ACC" + std::to_string(dis(gen));
+    return TAccountNumber(ACC_PREFIX_ID, 6, dis(gen));
 }
 
 // Generate random timestamp within 2024
-time_t GenerateRandomTimestamp(std::mt19937& gen) {
-    // January 1, 2024 00:00:00 UTC
-    struct tm tm2024start = {};
-    tm2024start.tm_year = 124; // 2024 - 1900
-    tm2024start.tm_mon = 0;    // January
-    tm2024start.tm_mday = 1;
-    time_t start2024 = mktime(&tm2024start);
-    
-    // December 31, 2024 23:59:59 UTC
-    struct tm tm2024end = {};
-    tm2024end.tm_year = 124; // 2024 - 1900
-    tm2024end.tm_mon = 11;   // December
-    tm2024end.tm_mday = 31;
-    tm2024end.tm_hour = 23;
-    tm2024end.tm_min = 59;
-    tm2024end.tm_sec = 59;
-    time_t end2024 = mktime(&tm2024end);
-    
-    std::uniform_int_distribution<time_t> dis(start2024, end2024);
+template<typename Generator>
+time_t GenerateRandomTimestamp(Generator& gen) {
+    const TYearBounds& bounds = YearBounds2024();
+    std::uniform_int_distribution<time_t> dis(bounds.start, bounds.end);
     return dis(gen);
 }
 
 // Generate random account type
-EBankAccountType GenerateRandomAccountType(std::mt19937& gen) {
+template<typename Generator>
+EBankAccountType GenerateRandomAccountType(Generator& gen) {
     std::uniform_int_distribution<> dis(0, 4);
     return static_cast<EBankAccountType>(dis(gen));
 }
 
+// Column-per-field store for bulk generated accounts. No per-account heap object or string:
+// names are indices into firstNames/lastNames and account numbers keep only the digits after "ACC".
+struct TAccountColumns {
+    std::vector<uint32_t> accountNumbers;
+    std::vector<uint8_t> accountTypes;
+    std::vector<uint16_t> firstNameIds;
+    std::vector<uint16_t> lastNameIds;
+    std::vector<time_t> creationTimestamps;
+    std::vector<double> balances;
+
+    size_t Size() const { return accountNumbers.size(); }
+
+    void Resize(size_t count) {
+        accountNumbers.resize(count);
+        accountTypes.resize(count);
+        firstNameIds.resize(count);
+        lastNameIds.resize(count);
+        creationTimestamps.resize(count);
+        balances.resize(count);
+    }
+
+    TAccountNumber AccountNumber(size_t row) const { return TAccountNumber(ACC_PREFIX_ID, 6, accountNumbers[row]); }
+
+    // Builds a heap TBankAccount for one row; caller owns the result
+    TBankAccount* Materialize(size_t row) const {
+        return new TBankAccount(AccountNumber(row), static_cast<EBankAccountType>(accountTypes[row]),
+                                firstNames[firstNameIds[row]], lastNames[lastNameIds[row]],
+                                creationTimestamps[row], balances[row]);
+    }
+};
+
+// Rows per generator stream in GenerateAccountsBulk
+const size_t BULK_BLOCK_ROWS = 1 << 16;
+
+// Fills one block of rows from its own stream
+void GenerateAccountBlock(TAccountColumns& out, size_t first, size_t last, TXoshiro256& gen) {
+    TTraceScope trace("GenerateAccountBlock");
+    const TYearBounds& bounds = YearBounds2024();
+    const uint32_t timestampRange = (uint32_t)(bounds.end - bounds.start + 1);
+    const uint32_t firstNameCount = (uint32_t)firstNames.size();
+    const uint32_t lastNameCount = (uint32_t)lastNames.size();
+    for (size_t row = first; row < last; row++) {
+        EBankAccountType accountType = static_cast<EBankAccountType>(gen.NextBelow(5));
+        out.accountNumbers[row] = 100000 + gen.NextBelow(900000);
+        out.accountTypes[row] = static_cast<uint8_t>(accountType);
+        out.firstNameIds[row] = (uint16_t)gen.NextBelow(firstNameCount);
+        out.lastNameIds[row] = (uint16_t)gen.NextBelow(lastNameCount);
+        out.creationTimestamps[row] = bounds.start + gen.NextBelow(timestampRange);
+        out.balances[row] = GenerateBalance(accountType, gen);
+    }
+}
+
+// Generates count accounts into out using threadCount threads (0 = hardware concurrency).
+// Every block of BULK_BLOCK_ROWS rows draws from its own stream derived from (seed, block),
+// so the output is identical for a given seed no matter how many threads run.
+// Time: O(n / threads), Space: O(n)
+void GenerateAccountsBulk(TAccountColumns& out, size_t count, uint64_t seed, unsigned threadCount = 0) {
+    TTraceScope trace("GenerateAccountsBulk");
+    out.Resize(count);
+    size_t blockCount = (count + BULK_BLOCK_ROWS - 1) / BULK_BLOCK_ROWS;
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = (unsigned)std::min<size_t>(threadCount, std::max<size_t>(blockCount, 1));
+
+    auto worker = [&](unsigned threadIndex) {
+        for (size_t block = threadIndex; block < blockCount; block += threadCount) {
+            uint64_t blockKey = block;
+            TXoshiro256 gen(seed ^ TXoshiro256::SplitMix64(blockKey));
+            size_t first = block * BULK_BLOCK_ROWS;
+            GenerateAccountBlock(out, first, std::min(count, first + BULK_BLOCK_ROWS), gen);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; t++) threads.emplace_back(worker, t);
+    worker(0);
+    for (auto& thread : threads) thread.join();
+}
+
+// Binary account file: a fixed header, one fixed-width array per numeric field and a string
+// heap that names and account numbers point into, so a mapped file is usable without parsing.
+// Layout (native byte order, every section 8-byte aligned):
+//   TAccountFileHeader | int64 timestamps[n] | double balances[n] | TStringRef accountNumbers[n]
+//   | TStringRef firstNames[n] | TStringRef lastNames[n] | uint8 accountTypes[n] | string heap
+const uint32_t ACCOUNT_FILE_MAGIC = 0x54434142; // "BACT"
+const uint32_t ACCOUNT_FILE_VERSION = 1;
+
+// Location of a string in the heap; strings are also NUL-terminated there
+struct TStringRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct TAccountFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t rowCount;
+    uint64_t timestampOffset;
+    uint64_t balanceOffset;
+    uint64_t accountNumberOffset;
+    uint64_t firstNameOffset;
+    uint64_t lastNameOffset;
+    uint64_t accountTypeOffset;
+    uint64_t heapOffset;
+    uint64_t heapSize;
+};
+
+static_assert(sizeof(TStringRef) == 8, "TStringRef must stay 8 bytes on disk");
+static_assert(sizeof(TAccountFileHeader) == 80, "TAccountFileHeader must stay 80 bytes on disk");
+
+// Collects rows column by column and writes them as one account file.
+// Names repeat across accounts, so each distinct name is stored in the heap once.
+class TAccountFileBuilder {
+private:
+    std::vector<int64_t> timestamps;
+    std::vector<double> balances;
+    std::vector<TStringRef> accountNumbers;
+    std::vector<TStringRef> firstNameRefs;
+    std::vector<TStringRef> lastNameRefs;
+    std::vector<uint8_t> accountTypes;
+    std::vector<char> heap;
+    std::unordered_map<std::string, TStringRef> internedNames;
+
+    TStringRef AppendToHeap(std::string_view text) {
+        if (heap.size() + text.size() + 1 > UINT32_MAX) throw std::length_error("Account file string heap exceeds 4 GB");
+        TStringRef ref = { (uint32_t)heap.size(), (uint32_t)text.size() };
+        heap.insert(heap.end(), text.begin(), text.end());
+        heap.push_back('\0');
+        return ref;
+    }
+
+    static uint64_t AlignUp(uint64_t offset) { return (offset + 7) & ~(uint64_t)7; }
+
+public:
+    void Reserve(size_t rows) {
+        timestamps.reserve(rows);
+        balances.reserve(rows);
+        accountNumbers.reserve(rows);
+        firstNameRefs.reserve(rows);
+        lastNameRefs.reserve(rows);
+        accountTypes.reserve(rows);
+        heap.reserve(rows * 16); // "ACC" + six digits + NUL per row, names are shared
+    }
+
+    // Returns the heap location of name, storing it on first use
+    TStringRef InternName(const std::string& name) {
+        auto it = internedNames.find(name);
+        if (it != internedNames.end()) return it->second;
+        TStringRef ref = AppendToHeap(name);
+        internedNames.emplace(name, ref);
+        return ref;
+    }
+
+    // Adds a row whose names were already interned (skips the hash lookups)
+    void Add(std::string_view accountNumber, EBankAccountType accountType, TStringRef firstName,
+             TStringRef lastName, time_t creationTimestamp, double balance) {
+        timestamps.push_back((int64_t)creationTimestamp);
+        balances.push_back(balance);
+        accountNumbers.push_back(AppendToHeap(accountNumber));
+        firstNameRefs.push_back(firstName);
+        lastNameRefs.push_back(lastName);
+        accountTypes.push_back(static_cast<uint8_t>(accountType));
+    }
+
+    void Add(std::string_view accountNumber, EBankAccountType accountType, const std::string& firstName,
+             const std::string& lastName, time_t creationTimestamp, double balance) {
+        Add(accountNumber, accountType, InternName(firstName), InternName(lastName), creationTimestamp, balance);
+    }
+
+    // Writes header, columns and heap; throws std::runtime_error when the file cannot be written
+    // Time: O(n), Space: O(1) beyond the collected rows
+    void Write(const std::string& path) const {
+        uint64_t rows = timestamps.size();
+        TAccountFileHeader header = {};
+        header.magic = ACCOUNT_FILE_MAGIC;
+        header.version = ACCOUNT_FILE_VERSION;
+        header.rowCount = rows;
+        header.timestampOffset = AlignUp(sizeof(TAccountFileHeader));
+        header.balanceOffset = AlignUp(header.timestampOffset + rows * sizeof(int64_t));
+        header.accountNumberOffset = AlignUp(header.balanceOffset + rows * sizeof(double));
+        header.firstNameOffset = AlignUp(header.accountNumberOffset + rows * sizeof(TStringRef));
+        header.lastNameOffset = AlignUp(header.firstNameOffset + rows * sizeof(TStringRef));
+        header.accountTypeOffset = AlignUp(header.lastNameOffset + rows * sizeof(TStringRef));
+        header.heapOffset = AlignUp(header.accountTypeOffset + rows * sizeof(uint8_t));
+        header.heapSize = heap.size();
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Cannot open account file for writing: " + path);
+        uint64_t written = 0;
+        auto writeAt = [&](uint64_t offset, const void* data, uint64_t bytes) {
+            static const char padding[8] = {};
+            out.write(padding, (std::streamsize)(offset - written));
+            out.write(static_cast<const char*>(data), (std::streamsize)bytes);
+            written = offset + bytes;
+        };
+        writeAt(0, &header, sizeof(header));
+        writeAt(header.timestampOffset, timestamps.data(), rows * sizeof(int64_t));
+        writeAt(header.balanceOffset, balances.data(), rows * sizeof(double));
+        writeAt(header.accountNumberOffset, accountNumbers.data(), rows * sizeof(TStringRef));
+        writeAt(header.firstNameOffset, firstNameRefs.data(), rows * sizeof(TStringRef));
+        writeAt(header.lastNameOffset, lastNameRefs.data(), rows * sizeof(TStringRef));
+        writeAt(header.accountTypeOffset, accountTypes.data(), rows * sizeof(uint8_t));
+        writeAt(header.heapOffset, heap.data(), heap.size());
+        if (!out) throw std::runtime_error("Failed writing account file: " + path);
+    }
+};
+
+// Writes an account array to path
+void WriteAccountFile(const std::string& path, TBankAccount** accountArray, int arraySize) {
+    TTraceScope trace("WriteAccountFile");
+    TAccountFileBuilder builder;
+    builder.Reserve(arraySize);
+    for (int i = 0; i < arraySize; i++) {
+        TBankAccount* account = accountArray[i];
+        builder.Add(account->accountNumber.ToString(), account->accountType, account->OwnerFirstName(),
+                    account->OwnerLastName(), account->creationTimestamp, account->balance);
+    }
+    builder.Write(path);
+}
+
+// Writes bulk generated columns to path
+void WriteAccountFile(const std::string& path, const TAccountColumns& columns) {
+    TTraceScope trace("WriteAccountFile");
+    TAccountFileBuilder builder;
+    builder.Reserve(columns.Size());
+    // The columns already hold name ids, so intern each name table entry once up front
+    std::vector<TStringRef> firstNameRefs, lastNameRefs;
+    for (const std::string& name : firstNames) firstNameRefs.push_back(builder.InternName(name));
+    for (const std::string& name : lastNames) lastNameRefs.push_back(builder.InternName(name));
+    char accountNumber[16];
+    for (size_t row = 0; row < columns.Size(); row++) {
+        int length = snprintf(accountNumber, sizeof(accountNumber), "ACC%u", columns.accountNumbers[row]);
+        builder.Add(std::string_view(accountNumber, length), static_cast<EBankAccountType>(columns.accountTypes[row]),
+                    firstNameRefs[columns.firstNameIds[row]], lastNameRefs[columns.lastNameIds[row]],
+                    columns.creationTimestamps[row], columns.balances[row]);
+    }
+    builder.Write(path);
+}
+
+// Read-only view of an account file. On POSIX the file is memory-mapped, so opening costs a
+// header check regardless of row count and pages load on first touch; elsewhere it is read
+// into memory once. Accessors return views into the mapping and stay valid while it is open.
+class TMappedAccountFile {
+private:
+    const char* base;
+    size_t fileSize;
+    std::vector<char> fallbackBuffer; // Only used where mmap is unavailable
+    const TAccountFileHeader* header;
+    const int64_t* timestamps;
+    const double* balances;
+    const TStringRef* accountNumbers;
+    const TStringRef* firstNameRefs;
+    const TStringRef* lastNameRefs;
+    const uint8_t* accountTypes;
+    const char* heap;
+
+    std::string_view Text(const TStringRef& ref) const { return std::string_view(heap + ref.offset, ref.length); }
+
+    void CheckSection(uint64_t offset, uint64_t bytes) const {
+        if (offset % 8 != 0 || offset > fileSize || bytes > fileSize - offset)
+            throw std::runtime_error("Account file is truncated or corrupt");
+    }
+
+    void Unmap() {
+#if defined(ACCOUNT_FILE_HAS_MMAP)
+        if (base && fallbackBuffer.empty()) munmap(const_cast<char*>(base), fileSize);
+#endif
+        base = nullptr;
+        fileSize = 0;
+        fallbackBuffer.clear();
+    }
+
+public:
+    TMappedAccountFile() : base(nullptr), fileSize(0), header(nullptr) {}
+    explicit TMappedAccountFile(const std::string& path) : TMappedAccountFile() { Open(path); }
+    ~TMappedAccountFile() { Unmap(); }
+
+    TMappedAccountFile(const TMappedAccountFile&) = delete;
+    TMappedAccountFile& operator=(const TMappedAccountFile&) = delete;
+
+    // Maps path and validates header and section bounds; throws std::runtime_error on failure
+    // Time: O(1) with mmap, Space: O(1) resident until rows are touched
+    void Open(const std::string& path) {
+        TTraceScope trace("TMappedAccountFile::Open");
+        Unmap();
+#if defined(ACCOUNT_FILE_HAS_MMAP)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open account file: " + path);
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(TAccountFileHeader)) {
+            close(fd);
+            throw std::runtime_error("Account file is truncated or corrupt");
+        }
+        fileSize = (size_t)info.st_size;
+        void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // The mapping keeps its own reference to the file
+        if (mapping == MAP_FAILED) {
+            fileSize = 0;
+            throw std::runtime_error("Cannot map account file: " + path);
+        }
+        base = static_cast<const char*>(mapping);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("Cannot open account file: " + path);
+        fallbackBuffer.resize((size_t)in.tellg());
+        in.seekg(0);
+        in.read(fallbackBuffer.data(), (std::streamsize)fallbackBuffer.size());
+        base = fallbackBuffer.data();
+        fileSize = fallbackBuffer.size();
+        if (fileSize < sizeof(TAccountFileHeader)) throw std::runtime_error("Account file is truncated or corrupt");
+#endif
+        header = reinterpret_cast<const TAccountFileHeader*>(base);
+        if (header->magic != ACCOUNT_FILE_MAGIC) throw std::runtime_error("Not an account file: " + path);
+        if (header->version != ACCOUNT_FILE_VERSION) throw std::runtime_error("Unsupported account file version");
+        uint64_t rows = header->rowCount;
+        if (rows > fileSize / sizeof(TStringRef)) throw std::runtime_error("Account file is truncated or corrupt");
+        CheckSection(header->timestampOffset, rows * sizeof(int64_t));
+        CheckSection(header->balanceOffset, rows * sizeof(double));
+        CheckSection(header->accountNumberOffset, rows * sizeof(TStringRef));
+        CheckSection(header->firstNameOffset, rows * sizeof(TStringRef));
+        CheckSection(header->lastNameOffset, rows * sizeof(TStringRef));
+        CheckSection(header->accountTypeOffset, rows * sizeof(uint8_t));
+        CheckSection(header->heapOffset, header->heapSize);
+        timestamps = reinterpret_cast<const int64_t*>(base + header->timestampOffset);
+        balances = reinterpret_cast<const double*>(base + header->balanceOffset);
+        accountNumbers = reinterpret_cast<const TStringRef*>(base + header->accountNumberOffset);
+        firstNameRefs = reinterpret_cast<const TStringRef*>(base + header->firstNameOffset);
+        lastNameRefs = reinterpret_cast<const TStringRef*>(base + header->lastNameOffset);
+        accountTypes = reinterpret_cast<const uint8_t*>(base + header->accountTypeOffset);
+        heap = base + header->heapOffset;
+    }
+
+    size_t Size() const { return header ? (size_t)header->rowCount : 0; }
+
+    std::string_view AccountNumber(size_t row) const { return Text(accountNumbers[row]); }
+    std::string_view FirstName(size_t row) const { return Text(firstNameRefs[row]); }
+    std::string_view LastName(size_t row) const { return Text(lastNameRefs[row]); }
+    EBankAccountType AccountType(size_t row) const { return static_cast<EBankAccountType>(accountTypes[row]); }
+    time_t CreationTimestamp(size_t row) const { return (time_t)timestamps[row]; }
+    double Balance(size_t row) const { return balances[row]; }
+
+    // Contiguous numeric columns for scans that should not go through per-row accessors
+    const double* Balances() const { return balances; }
+    const int64_t* Timestamps() const { return timestamps; }
+
+    // Linear search over the mapped account number column, no account objects involved
+    // Time: O(n), Space: O(1)
+    long long FindRow(std::string_view accountNumber, SearchSummary& summary) const {
+        summary = SearchSummary();
+        TTraceScope trace("TMappedAccountFile::FindRow");
+        TPerfScope<SearchSummary> scope(summary);
+        for (size_t row = 0; row < Size(); row++) {
+            summary.comparisons++;
+            if (AccountNumber(row) == accountNumber) return (long long)row;
+        }
+        return -1;
+    }
+
+    // Builds a heap TBankAccount for one row; caller owns the result
+    TBankAccount* Materialize(size_t row) const {
+        return new TBankAccount(AccountNumber(row), AccountType(row), std::string(FirstName(row)),
+                                std::string(LastName(row)), CreationTimestamp(row), Balance(row));
+    }
+};
+
+// Name used for an account type in CSV files
+const char* AccountTypeName(EBankAccountType accountType) {
+    switch (accountType) {
+        case EBankAccountType::Checking: return "Checking";
+        case EBankAccountType::Savings:  return "Savings";
+        case EBankAccountType::Credit:   return "Credit";
+        case EBankAccountType::Pension:  return "Pension";
+        case EBankAccountType::Loan:     return "Loan";
+    }
+    return "Unknown";
+}
+
+bool ParseAccountType(std::string_view text, EBankAccountType& accountType) {
+    static const EBankAccountType types[] = { EBankAccountType::Checking, EBankAccountType::Savings,
+                                              EBankAccountType::Credit, EBankAccountType::Pension,
+                                              EBankAccountType::Loan };
+    for (EBankAccountType type : types) {
+        if (text == AccountTypeName(type)) {
+            accountType = type;
+            return true;
+        }
+    }
+    return false;
+}
+
+// First line of account CSV files; skipped by the ingest pipeline when present
+const char* const ACCOUNT_CSV_HEADER = "accountNumber,accountType,firstName,lastName,creationTimestamp,balance";
+
+// One parsed CSV row. The account number is already packed; the name fields point into the
+// chunk the row was parsed from and are only valid while the ingest sink is running.
+struct TCsvAccountRow {
+    TAccountNumber accountNumber;
+    EBankAccountType accountType;
+    std::string_view firstName;
+    std::string_view lastName;
+    time_t creationTimestamp;
+    double balance;
+};
+
+// Parses one "accountNumber,type,firstName,lastName,timestamp,balance" line (a trailing '\r'
+// is allowed) without allocating; returns false for malformed lines, including account numbers
+// TAccountNumber::Parse rejects, so they are counted as bad rows instead of throwing in the sink
+// Time: O(line length), Space: O(1)
+bool ParseAccountCsvLine(const char* begin, const char* end, TCsvAccountRow& row) {
+    if (end > begin && end[-1] == '\r') --end;
+    std::string_view fields[6];
+    int fieldCount = 0;
+    const char* fieldStart = begin;
+    for (const char* p = begin; ; ++p) {
+        if (p == end || *p == ',') {
+            if (fieldCount == 6) return false; // Too many fields
+            fields[fieldCount++] = std::string_view(fieldStart, p - fieldStart);
+            if (p == end) break;
+            fieldStart = p + 1;
+        }
+    }
+    if (fieldCount != 6) return false;
+    if (!ParseAccountType(fields[1], row.accountType)) return false;
+
+    int64_t timestamp;
+    const char* timeEnd = fields[4].data() + fields[4].size();
+    auto timeResult = std::from_chars(fields[4].data(), timeEnd, timestamp);
+    if (timeResult.ec != std::errc() || timeResult.ptr != timeEnd) return false;
+
+    const char* balanceEnd = fields[5].data() + fields[5].size();
+    auto balanceResult = std::from_chars(fields[5].data(), balanceEnd, row.balance);
+    if (balanceResult.ec != std::errc() || balanceResult.ptr != balanceEnd) return false;
+
+    // Last, so lines rejected for other fields never register a new prefix
+    if (!TAccountNumber::Parse(fields[0], row.accountNumber)) return false;
+    row.firstName = fields[2];
+    row.lastName = fields[3];
+    row.creationTimestamp = (time_t)timestamp;
+    return true;
+}
+
+// Writes the first count bulk rows as CSV with a header line.
+// Balances use the shortest text that reads back to the same double.
+void WriteAccountCsv(const std::string& path, const TAccountColumns& columns, size_t count) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) throw std::runtime_error("Cannot open CSV file for writing: " + path);
+    const size_t flushBytes = 1 << 20;
+    std::string buffer;
+    buffer.reserve(flushBytes + 256);
+    buffer += ACCOUNT_CSV_HEADER;
+    buffer += '\n';
+    char number[32];
+    count = std::min(count, columns.Size());
+    for (size_t row = 0; row < count; row++) {
+        buffer += "ACC";
+        buffer.append(number, std::to_chars(number, number + sizeof(number), columns.accountNumbers[row]).ptr);
+        buffer += ',';
+        buffer += AccountTypeName(static_cast<EBankAccountType>(columns.accountTypes[row]));
+        buffer += ',';
+        buffer += firstNames[columns.firstNameIds[row]];
+        buffer += ',';
+        buffer += lastNames[columns.lastNameIds[row]];
+        buffer += ',';
+        buffer.append(number, std::to_chars(number, number + sizeof(number), (int64_t)columns.creationTimestamps[row]).ptr);
+        buffer += ',';
+        buffer.append(number, std::to_chars(number, number + sizeof(number), columns.balances[row]).ptr);
+        buffer += '\n';
+        if (buffer.size() >= flushBytes) {
+            fwrite(buffer.data(), 1, buffer.size(), file);
+            buffer.clear();
+        }
+    }
+    fwrite(buffer.data(), 1, buffer.size(), file);
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    if (failed) throw std::runtime_error("Failed writing CSV file: " + path);
+}
+
+// Blocking FIFO with a fixed capacity: Push waits while the queue is full, so a producer is
+// held to the pace of its consumers. After Close(), Push fails and Pop drains what is left.
+template<typename T>
+class TBoundedQueue {
+private:
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    std::deque<T> items;
+    size_t capacity;
+    bool closed;
+
+public:
+    explicit TBoundedQueue(size_t capacity) : capacity(std::max<size_t>(capacity, 1)), closed(false) {}
+
+    // Returns false if the queue was closed before the item could be added
+    bool Push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&] { return items.size() < capacity || closed; });
+        if (closed) return false;
+        items.push_back(std::move(item));
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Returns false once the queue is closed and empty
+    bool Pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+        item = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return true;
+    }
+
+    void Close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
+
+// Counting semaphore (std::counting_semaphore needs C++20). Cancel() wakes every waiter and
+// makes Acquire fail from then on.
+class TCountingSemaphore {
+private:
+    std::mutex mutex;
+    std::condition_variable available;
+    size_t count;
+    bool cancelled;
+
+public:
+    explicit TCountingSemaphore(size_t count) : count(count), cancelled(false) {}
+
+    bool Acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        available.wait(lock, [&] { return count > 0 || cancelled; });
+        if (cancelled) return false;
+        count--;
+        return true;
+    }
+
+    void Release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            count++;
+        }
+        available.notify_one();
+    }
+
+    void Cancel() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            cancelled = true;
+        }
+        available.notify_all();
+    }
+};
+
+// IngestSummary struct to hold throughput data for one CSV ingest
+struct IngestSummary {
+    long long rows;         // Rows handed to the sink
+    long long badRows;      // Malformed lines that were skipped
+    long long bytes;        // Bytes read from the file
+    long long chunks;       // Blocks the file was cut into
+    double timeSpentMs;     // Wall time from open to last row sunk
+
+    IngestSummary() : rows(0), badRows(0), bytes(0), chunks(0), timeSpentMs(0.0) {}
+
+    double MegabytesPerSecond() const { return timeSpentMs > 0 ? bytes / (1024.0 * 1024.0) / (timeSpentMs / 1000.0) : 0.0; }
+    double RowsPerSecond() const { return timeSpentMs > 0 ? rows / (timeSpentMs / 1000.0) : 0.0; }
+};
+
+// Receives ingested rows in file order on the thread that called IngestAccountCsv
+typedef std::function<void(const TCsvAccountRow& row)> FIngestRow;
+
+// Streams an account CSV file through a read -> parse -> sink pipeline:
+// - a reader thread reads blockBytes at a time and cuts every block after its last newline,
+// - parserThreads threads (0 = hardware concurrency) parse chunks into rows with no per-field allocation,
+// - the calling thread passes rows to sink in file order, reassembling chunks by sequence number.
+// At most maxChunksInFlight chunks exist between being read and being sunk, so memory stays near
+// maxChunksInFlight * blockBytes for any file size and a slow sink throttles the reader.
+// Throws std::runtime_error if the file cannot be read; an exception from sink stops the
+// pipeline and is rethrown.
+// Time: O(bytes / parserThreads) parsing plus the sink's cost, Space: O(maxChunksInFlight * blockBytes)
+IngestSummary IngestAccountCsv(const std::string& path, const FIngestRow& sink, unsigned parserThreads = 0,
+                               size_t blockBytes = 1 << 20, size_t maxChunksInFlight = 8) {
+    TTraceScope trace("IngestAccountCsv");
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) throw std::runtime_error("Cannot open CSV file: " + path);
+    if (parserThreads == 0) parserThreads = std::max(1u, std::thread::hardware_concurrency());
+    blockBytes = std::max<size_t>(blockBytes, 64);
+    maxChunksInFlight = std::max<size_t>(maxChunksInFlight, 1);
+
+    struct TChunk {
+        uint64_t sequence;
+        std::vector<char> text;
+        std::vector<TCsvAccountRow> rows; // Views into text; moving the chunk keeps them valid
+        long long badRows;
+        TChunk() : sequence(0), badRows(0) {}
+    };
+
+    IngestSummary summary;
+    auto start = std::chrono::steady_clock::now();
+    TBoundedQueue<TChunk> rawChunks(maxChunksInFlight);
+    TBoundedQueue<TChunk> parsedChunks(maxChunksInFlight);
+    TCountingSemaphore window(maxChunksInFlight);
+    long long bytesRead = 0;
+    std::exception_ptr readError;
+
+    std::thread reader([&]() {
+        try {
+            std::vector<char> carry; // Partial last line of the previous block
+            uint64_t sequence = 0;
+            bool endOfFile = false;
+            while (!endOfFile && window.Acquire()) {
+                TTraceScope readTrace("IngestAccountCsv read block");
+                TChunk chunk;
+                chunk.text.swap(carry);
+                size_t used = chunk.text.size();
+                chunk.text.resize(used + blockBytes);
+                size_t got = fread(chunk.text.data() + used, 1, blockBytes, file);
+                if (ferror(file)) throw std::runtime_error("Failed reading CSV file: " + path);
+                bytesRead += (long long)got;
+                chunk.text.resize(used + got);
+                endOfFile = got < blockBytes;
+
+                if (!endOfFile) {
+                    size_t cut = chunk.text.size();
+                    while (cut > 0 && chunk.text[cut - 1] != '\n') cut--;
+                    if (cut == 0) {
+                        // A line longer than the block: keep reading into the same buffer
+                        carry.swap(chunk.text);
+                        window.Release();
+                        continue;
+                    }
+                    carry.assign(chunk.text.begin() + cut, chunk.text.end());
+                    chunk.text.resize(cut);
+                }
+                if (sequence == 0) {
+                    size_t headerLength = strlen(ACCOUNT_CSV_HEADER);
+                    if (chunk.text.size() >= headerLength &&
+                        std::string_view(chunk.text.data(), headerLength) == ACCOUNT_CSV_HEADER) {
+                        auto lineEnd = std::find(chunk.text.begin(), chunk.text.end(), '\n');
+                        chunk.text.erase(chunk.text.begin(), lineEnd == chunk.text.end() ? lineEnd : lineEnd + 1);
+                    }
+                }
+                if (chunk.text.empty()) {
+                    window.Release();
+                    continue;
+                }
+                chunk.sequence = sequence++;
+                if (!rawChunks.Push(std::move(chunk))) break;
+            }
+        } catch (...) {
+            readError = std::current_exception();
+        }
+        rawChunks.Close();
+    });
+
+    std::atomic<unsigned> parsersRunning(parserThreads);
+    std::vector<std::thread> parsers;
+    for (unsigned t = 0; t < parserThreads; t++) {
+        parsers.emplace_back([&]() {
+            TChunk chunk;
+            while (rawChunks.Pop(chunk)) {
+                TTraceScope parseTrace("IngestAccountCsv parse chunk");
+                const char* p = chunk.text.data();
+                const char* end = p + chunk.text.size();
+                chunk.rows.reserve(chunk.text.size() / 48);
+                while (p < end) {
+                    const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+                    if (!lineEnd) lineEnd = end;
+                    bool blank = lineEnd == p || (lineEnd - p == 1 && *p == '\r');
+                    if (!blank) {
+                        TCsvAccountRow row;
+                        if (ParseAccountCsvLine(p, lineEnd, row)) chunk.rows.push_back(row);
+                        else chunk.badRows++;
+                    }
+                    p = lineEnd + 1;
+                }
+                if (!parsedChunks.Push(std::move(chunk))) break;
+                chunk = TChunk();
+            }
+            if (--parsersRunning == 0) parsedChunks.Close();
+        });
+    }
+
+    // Sink stage: chunks can finish parsing out of order, so hold them until their turn
+    std::map<uint64_t, TChunk> pending;
+    uint64_t nextSequence = 0;
+    std::exception_ptr sinkError;
+    TChunk parsed;
+    while (!sinkError && parsedChunks.Pop(parsed)) {
+        uint64_t sequence = parsed.sequence;
+        pending.emplace(sequence, std::move(parsed));
+        parsed = TChunk();
+        for (auto it = pending.find(nextSequence); it != pending.end(); it = pending.find(nextSequence)) {
+            TTraceScope sinkTrace("IngestAccountCsv sink chunk");
+            try {
+                for (const TCsvAccountRow& row : it->second.rows) sink(row);
+            } catch (...) {
+                sinkError = std::current_exception();
+            }
+            summary.rows += (long long)it->second.rows.size();
+            summary.badRows += it->second.badRows;
+            summary.chunks++;
+            pending.erase(it);
+            nextSequence++;
+            window.Release();
+            if (sinkError) break;
+        }
+    }
+    if (sinkError) {
+        // Unblock every stage so the threads can be joined
+        window.Cancel();
+        rawChunks.Close();
+        parsedChunks.Close();
+    }
+
+    reader.join();
+    for (auto& parser : parsers) parser.join();
+    fclose(file);
+    summary.bytes = bytesRead;
+    summary.timeSpentMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (sinkError) std::rethrow_exception(sinkError);
+    if (readError) std::rethrow_exception(readError);
+    return summary;
+}
+
 // Callback functions for search demonstrations
+// Key is a const char* account number. It is parsed on every call (no std::string is built);
+// CompareByAccountKey skips even that when the caller parses the key once.
 bool CompareByAccountNumber(TBankAccount* account, void* searchKey) {
-    const char* targetAccountNumber = static_cast<const char*>(searchKey);
-    return account->accountNumber == std::string(targetAccountNumber);
+    TAccountNumber target;
+    return TAccountNumber::Lookup(static_cast<const char*>(searchKey), target) && account->accountNumber == target;
+}
+
+// Key is a TAccountNumber*, so each node costs one 64-bit compare
+bool CompareByAccountKey(TBankAccount* account, void* searchKey) {
+    return account->accountNumber == *static_cast<const TAccountNumber*>(searchKey);
 }
 
 bool CompareByAccountType(TBankAccount* account, void* searchKey) {
@@ -394,44 +1882,51 @@ bool CompareByMonth(TBankAccount* account, void* searchKey) {
 
 bool CompareByLastNameStartsWith(TBankAccount* account, void* searchKey) {
     char targetLetter = *static_cast<char*>(searchKey);
-    return !account->ownerLastName.empty() && 
-           std::toupper(account->ownerLastName[0]) == std::toupper(targetLetter);
+    const std::string& lastName = account->OwnerLastName();
+    return !lastName.empty() && 
+           std::toupper(lastName[0]) == std::toupper(targetLetter);
+}
+
+// Key is a uint32_t* last-name id from NameDictionary(), so each node costs one integer compare
+bool CompareByLastName(TBankAccount* account, void* searchKey) {
+    uint32_t lastNameId = *static_cast<uint32_t*>(searchKey);
+    return account->ownerLastNameId == lastNameId;
 }
 
 // Standalone search functions for array operations
 
-// Standalone function to find account by number in an array
+// Standalone function to find account by packed number in an array
 TBankAccount* FindAccountByNumber(TBankAccount** accountArray, int arraySize, 
-                                  const std::string& accountNumber, SearchSummary& summary) {
-    // Reset summary
-    summary.comparisons = 0;
-    summary.timeSpentMs = 0.0;
-    
-    // Start timing
-    auto start = std::chrono::high_resolution_clock::now();
+                                  TAccountNumber accountNumber, SearchSummary& summary) {
+    // Reset summary and start measuring
+    summary = SearchSummary();
+    TTraceScope trace("FindAccountByNumber");
+    TPerfScope<SearchSummary> scope(summary);
     
     // Linear search through the array
     for (int i = 0; i < arraySize; i++) {
         summary.comparisons++;
         
         if (accountArray[i] && accountArray[i]->accountNumber == accountNumber) {
-            // End timing
-            auto end = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-            summary.timeSpentMs = duration.count() / 1000.0; // Convert to milliseconds
-            
             return accountArray[i];
         }
     }
     
-    // End timing (no match found)
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    summary.timeSpentMs = duration.count() / 1000.0; // Convert to milliseconds
-    
     return nullptr;
 }
 
+// Text overload: the key is parsed once; a number that cannot parse (or has an unknown prefix)
+// matches no account
+TBankAccount* FindAccountByNumber(TBankAccount** accountArray, int arraySize, 
+                                  const std::string& accountNumber, SearchSummary& summary) {
+    TAccountNumber key;
+    if (!TAccountNumber::Lookup(accountNumber, key)) {
+        summary = SearchSummary();
+        return nullptr;
+    }
+    return FindAccountByNumber(accountArray, arraySize, key, summary);
+}
+
 // FINAL REPORT - FLEXIBILITY COMPARISON:
 // PrintEveryAccountInDateRange() demonstrates SPECIFIC APPROACH benefits:
 // PROS: - Simple to use for date range queries (no callbacks needed)
@@ -450,12 +1945,10 @@ TBankAccount* FindAccountByNumber(TBankAccount** accountArray, int arraySize,
 // Standalone function to print all accounts within a date range
 void PrintEveryAccountInDateRange(TBankAccount** accountArray, int arraySize, 
                                   time_t fromDate, time_t toDate, SearchSummary& summary) {
-    // Reset summary
-    summary.comparisons = 0;
-    summary.timeSpentMs = 0.0;
-    
-    // Start timing
-    auto start = std::chrono::high_resolution_clock::now();
+    // Reset summary and start measuring
+    summary = SearchSummary();
+    TTraceScope trace("PrintEveryAccountInDateRange");
+    TPerfScope<SearchSummary> scope(summary);
     
     std::cout << "\nAccounts created between " << ctime(&fromDate) 
               << "and " << ctime(&toDate) << std::endl;
@@ -472,8 +1965,8 @@ void PrintEveryAccountInDateRange(TBankAccount** accountArray, int arraySize,
             
             foundCount++;
             std::cout << "  " << accountArray[i]->accountNumber 
-                     << " - " << accountArray[i]->ownerFirstName 
-                     << " " << accountArray[i]->ownerLastName
+                     << " - " << accountArray[i]->OwnerFirstName() 
+                     << " " << accountArray[i]->OwnerLastName()
                      << " (Created: " << ctime(&accountArray[i]->creationTimestamp) << ")" << std::endl;
         }
     }
@@ -482,11 +1975,7 @@ void PrintEveryAccountInDateRange(TBankAccount** accountArray, int arraySize,
         std::cout << "  No accounts found in the specified date range." << std::endl;
     }
     
-    // End timing
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    summary.timeSpentMs = duration.count() / 1000.0; // Convert to milliseconds
-    
+    scope.Stop();
     std::cout << "Found " << foundCount << " accounts in date range." << std::endl;
 }
 
@@ -495,14 +1984,330 @@ void PrintEveryAccountInDateRange(TBankAccount** accountArray, int arraySize,
 // Results show clear O(n) complexity patterns and performance characteristics
 // documented throughout execution for analysis and comparison
 
-int main() {
+// Benchmark harness, run with --bench. Sweeps list sizes and distributions, runs Find(), Every()
+// and the standalone array searches with warmups and repetitions, and writes one row per
+// (operation, distribution, n) with time percentiles and comparison counts as CSV or JSON.
+// Options:
+//   --sizes 1000,10000,...   list sizes (default 1000,10000,100000; 100M needs roughly 10 GB)
+//   --dist random,sorted,reverse,nearly,fewunique,dupnames   input distributions (default all);
+//                            ordering is by account number, fewunique/dupnames shrink the name pool
+//   --warmup N --reps N      untimed and timed runs per cell (default 1 and 5)
+//   --format csv|json --out FILE   output format and file (default csv on stdout)
+//   --seed N                 seed for the generated accounts
+//   --counters               also record hardware counters (n/a where perf_event_open is refused)
+//   --trace FILE, --trace-folded FILE   also write a Chrome trace / folded stacks of the run
+// Point lookups are timed as a batch of BENCH_POINT_LOOKUPS keys so small lists still measure
+// above the clock resolution.
+const int BENCH_POINT_LOOKUPS = 100;
+
+struct TBenchConfig {
+    std::vector<int> sizes;
+    std::vector<std::string> distributions;
+    int warmups;
+    int repetitions;
+    std::string format;
+    std::string outputPath;
+    uint64_t seed;
+
+    TBenchConfig()
+        : sizes{ 1000, 10000, 100000 },
+          distributions{ "random", "sorted", "reverse", "nearly", "fewunique", "dupnames" },
+          warmups(1), repetitions(5), format("csv"), seed(DEFAULT_SEED) {}
+};
+
+// Timings and counts for one (operation, distribution, n) cell
+struct TBenchResult {
+    std::string operation;
+    std::string distribution;
+    int n;
+    std::vector<double> timesMs;
+    long long comparisons; // From the last repetition; inputs are identical between repetitions
+    long long bytesAllocated;
+    PerfCounters counters; // From the last repetition
+};
+
+// Swallows everything written to it; stands in for std::cout while PrintEveryAccountInDateRange runs
+class TNullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+// Value at fraction p (0..1) of sorted samples, interpolating between neighbours
+double Percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    double position = p * (sorted.size() - 1);
+    size_t below = (size_t)position;
+    size_t above = std::min(below + 1, sorted.size() - 1);
+    return sorted[below] + (sorted[above] - sorted[below]) * (position - below);
+}
+
+// Builds n accounts for a distribution. Caller owns the accounts.
+std::vector<TBankAccount*> MakeBenchAccounts(const std::string& distribution, int n, uint64_t seed) {
+    TXoshiro256 gen(seed);
+    const TYearBounds& bounds = YearBounds2024();
+    bool fewUnique = distribution == "fewunique";
+    bool duplicateNames = distribution == "dupnames";
+    std::vector<TBankAccount*> accounts;
+    accounts.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        EBankAccountType type = static_cast<EBankAccountType>(gen.NextBelow(5));
+        // fewunique: 2 x 2 names and 8 balances; dupnames: only 3 last names
+        const std::string& first = firstNames[gen.NextBelow(fewUnique ? 2 : (uint32_t)firstNames.size())];
+        const std::string& last = lastNames[gen.NextBelow(fewUnique ? 2 : duplicateNames ? 3 : (uint32_t)lastNames.size())];
+        double balance = fewUnique ? 100.0 * gen.NextBelow(8) : GenerateBalance(type, gen);
+        time_t timestamp = bounds.start + gen.NextBelow((uint32_t)(bounds.end - bounds.start));
+        accounts.push_back(new TBankAccount(GenerateAccountNumber(gen), type, first, last, timestamp, balance));
+    }
+    if (distribution == "sorted" || distribution == "reverse" || distribution == "nearly") {
+        std::sort(accounts.begin(), accounts.end(), [](TBankAccount* a, TBankAccount* b) { return a->accountNumber < b->accountNumber; });
+    }
+    if (distribution == "reverse") std::reverse(accounts.begin(), accounts.end());
+    if (distribution == "nearly") {
+        for (int i = 0; i < n / 100; ++i) std::swap(accounts[gen.NextBelow(n)], accounts[gen.NextBelow(n)]);
+    }
+    return accounts;
+}
+
+// Runs warmups untimed, then repetitions timed by the SearchSummary that run fills in
+TBenchResult RunBenchCell(const std::string& operation, const std::string& distribution, int n, const TBenchConfig& config,
+                          const std::function<void(SearchSummary&)>& run) {
+    TBenchResult result;
+    result.operation = operation;
+    result.distribution = distribution;
+    result.n = n;
+    SearchSummary summary;
+    for (int i = 0; i < config.warmups; ++i) run(summary);
+    for (int i = 0; i < config.repetitions; ++i) {
+        run(summary);
+        result.timesMs.push_back(summary.timeSpentMs);
+    }
+    result.comparisons = summary.comparisons;
+    result.bytesAllocated = summary.bytesAllocated;
+    result.counters = summary.counters;
+    std::sort(result.timesMs.begin(), result.timesMs.end());
+    return result;
+}
+
+// Measures a batch of calls as one scope, summing the comparisons each call reports
+SearchSummary TimeBatch(const std::function<void(SearchSummary&)>& each, int count) {
+    SearchSummary total, one;
+    {
+        TPerfScope<SearchSummary> scope(total);
+        for (int i = 0; i < count; ++i) {
+            each(one);
+            total.comparisons += one.comparisons;
+        }
+    }
+    return total;
+}
+
+// Counter value for the output formats; unavailable counters become missingText
+std::string BenchCounter(long long value, const char* missingText) {
+    return value < 0 ? std::string(missingText) : std::to_string(value);
+}
+
+void WriteBenchCsv(std::ostream& out, const std::vector<TBenchResult>& results) {
+    out << "operation,distribution,n,repetitions,min_ms,median_ms,p90_ms,p99_ms,max_ms,comparisons,"
+        << "bytes_allocated,cycles,instructions,cache_misses,branch_misses\n";
+    for (const TBenchResult& r : results) {
+        out << r.operation << "," << r.distribution << "," << r.n << "," << r.timesMs.size() << ","
+            << r.timesMs.front() << "," << Percentile(r.timesMs, 0.5) << "," << Percentile(r.timesMs, 0.9) << ","
+            << Percentile(r.timesMs, 0.99) << "," << r.timesMs.back() << "," << r.comparisons << ","
+            << r.bytesAllocated << "," << BenchCounter(r.counters.cycles, "n/a") << "," << BenchCounter(r.counters.instructions, "n/a") << ","
+            << BenchCounter(r.counters.cacheMisses, "n/a") << "," << BenchCounter(r.counters.branchMisses, "n/a") << "\n";
+    }
+}
+
+void WriteBenchJson(std::ostream& out, const std::vector<TBenchResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const TBenchResult& r = results[i];
+        out << "  {\"operation\": \"" << r.operation << "\", \"distribution\": \"" << r.distribution
+            << "\", \"n\": " << r.n << ", \"repetitions\": " << r.timesMs.size()
+            << ", \"min_ms\": " << r.timesMs.front() << ", \"median_ms\": " << Percentile(r.timesMs, 0.5)
+            << ", \"p90_ms\": " << Percentile(r.timesMs, 0.9) << ", \"p99_ms\": " << Percentile(r.timesMs, 0.99)
+            << ", \"max_ms\": " << r.timesMs.back() << ", \"comparisons\": " << r.comparisons
+            << ", \"bytes_allocated\": " << r.bytesAllocated
+            << ", \"cycles\": " << BenchCounter(r.counters.cycles, "null") << ", \"instructions\": " << BenchCounter(r.counters.instructions, "null")
+            << ", \"cache_misses\": " << BenchCounter(r.counters.cacheMisses, "null")
+            << ", \"branch_misses\": " << BenchCounter(r.counters.branchMisses, "null")
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+// Parses the --bench options; returns false with a message for anything unknown or malformed
+bool ParseBenchArgs(int argc, char** argv, TBenchConfig& config, std::string& error) {
+    auto splitList = [](const std::string& text) {
+        std::vector<std::string> items;
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) if (!item.empty()) items.push_back(item);
+        return items;
+    };
+    static const std::vector<std::string> knownDistributions = { "random", "sorted", "reverse", "nearly", "fewunique", "dupnames" };
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--bench") continue;
+            if (arg == "--counters") { SetPerfCountersEnabled(true); continue; }
+            if (i + 1 >= argc) { error = "Missing value for " + arg; return false; }
+            std::string value = argv[++i];
+            if (arg == "--sizes") {
+                config.sizes.clear();
+                for (const std::string& size : splitList(value)) {
+                    int n = std::stoi(size);
+                    if (n < 1) { error = "Sizes must be positive"; return false; }
+                    config.sizes.push_back(n);
+                }
+            } else if (arg == "--dist") {
+                config.distributions = splitList(value);
+                for (const std::string& d : config.distributions) {
+                    if (std::find(knownDistributions.begin(), knownDistributions.end(), d) == knownDistributions.end()) {
+                        error = "Unknown distribution: " + d;
+                        return false;
+                    }
+                }
+            } else if (arg == "--warmup") {
+                config.warmups = std::max(0, std::stoi(value));
+            } else if (arg == "--reps") {
+                config.repetitions = std::max(1, std::stoi(value));
+            } else if (arg == "--format") {
+                if (value != "csv" && value != "json") { error = "Format must be csv or json"; return false; }
+                config.format = value;
+            } else if (arg == "--out") {
+                config.outputPath = value;
+            } else if (arg == "--seed") {
+                config.seed = std::stoull(value);
+            } else if (arg == "--trace" || arg == "--trace-folded") {
+                // Handled in main
+            } else {
+                error = "Unknown option: " + arg;
+                return false;
+            }
+        }
+    } catch (const std::exception&) {
+        error = "Malformed number in arguments";
+        return false;
+    }
+    return true;
+}
+
+// Runs the whole sweep; progress goes to stderr so stdout carries only the results
+int RunBenchmarks(const TBenchConfig& config) {
+    std::vector<TBenchResult> results;
+    for (int n : config.sizes) {
+        for (const std::string& distribution : config.distributions) {
+            std::cerr << "bench: n=" << n << " distribution=" << distribution << std::endl;
+            std::vector<TBankAccount*> accounts = MakeBenchAccounts(distribution, n, config.seed);
+            TLinkedList<TBankAccount> list(false);
+            for (TBankAccount* account : accounts) list.add(account);
+
+            // Lookup keys are drawn from the accounts, so every point lookup is a hit
+            TXoshiro256 keyGen(config.seed ^ (uint64_t)n);
+            std::vector<TAccountNumber> hitKeys(BENCH_POINT_LOOKUPS);
+            std::vector<std::string> hitKeyText(BENCH_POINT_LOOKUPS);
+            for (int i = 0; i < BENCH_POINT_LOOKUPS; ++i) {
+                hitKeys[i] = accounts[keyGen.NextBelow(n)]->accountNumber;
+                hitKeyText[i] = hitKeys[i].ToString();
+            }
+            TAccountNumber missingKey(ACC_PREFIX_ID, 9, 999999999);
+            uint32_t lastNameId = accounts[keyGen.NextBelow(n)]->ownerLastNameId;
+            EBankAccountType checking = EBankAccountType::Checking;
+            const TYearBounds& bounds = YearBounds2024();
+            time_t rangeFrom = bounds.start + (bounds.end - bounds.start) / 2;
+            time_t rangeTo = rangeFrom + 30 * 24 * 3600;
+            const std::string batch = " x" + std::to_string(BENCH_POINT_LOOKUPS);
+
+            results.push_back(RunBenchCell("Find(CompareByAccountKey)" + batch, distribution, n, config, [&](SearchSummary& s) {
+                int next = 0;
+                s = TimeBatch([&](SearchSummary& one) { list.Find(CompareByAccountKey, &hitKeys[next++], one); }, BENCH_POINT_LOOKUPS);
+            }));
+            results.push_back(RunBenchCell("Find(CompareByAccountNumber)" + batch, distribution, n, config, [&](SearchSummary& s) {
+                int next = 0;
+                s = TimeBatch([&](SearchSummary& one) {
+                    list.Find(CompareByAccountNumber, const_cast<char*>(hitKeyText[next++].c_str()), one);
+                }, BENCH_POINT_LOOKUPS);
+            }));
+            results.push_back(RunBenchCell("Find(CompareByAccountKey) miss", distribution, n, config, [&](SearchSummary& s) {
+                s = TimeBatch([&](SearchSummary& one) { list.Find(CompareByAccountKey, &missingKey, one); }, 1);
+            }));
+            results.push_back(RunBenchCell("Every(CompareByLastName)", distribution, n, config, [&](SearchSummary& s) {
+                s = TimeBatch([&](SearchSummary& one) { delete list.Every(CompareByLastName, &lastNameId, one); }, 1);
+            }));
+            results.push_back(RunBenchCell("Every(CompareByAccountType)", distribution, n, config, [&](SearchSummary& s) {
+                s = TimeBatch([&](SearchSummary& one) { delete list.Every(CompareByAccountType, &checking, one); }, 1);
+            }));
+            results.push_back(RunBenchCell("FindAccountByNumber" + batch, distribution, n, config, [&](SearchSummary& s) {
+                int next = 0;
+                s = TimeBatch([&](SearchSummary& one) { FindAccountByNumber(accounts.data(), n, hitKeys[next++], one); }, BENCH_POINT_LOOKUPS);
+            }));
+            results.push_back(RunBenchCell("PrintEveryAccountInDateRange", distribution, n, config, [&](SearchSummary& s) {
+                // Matches are printed into a null buffer so the terminal is not part of the measurement
+                TNullBuffer nullBuffer;
+                std::streambuf* original = std::cout.rdbuf(&nullBuffer);
+                s = TimeBatch([&](SearchSummary& one) { PrintEveryAccountInDateRange(accounts.data(), n, rangeFrom, rangeTo, one); }, 1);
+                std::cout.rdbuf(original);
+            }));
+
+            for (TBankAccount* account : accounts) delete account;
+        }
+    }
+
+    std::ofstream file;
+    if (!config.outputPath.empty()) {
+        file.open(config.outputPath);
+        if (!file) {
+            std::cerr << "bench: cannot write " << config.outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = config.outputPath.empty() ? std::cout : file;
+    if (config.format == "json") WriteBenchJson(out, results);
+    else WriteBenchCsv(out, results);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    // --bench runs the benchmark suite instead of the demo
+    // --counters attaches hardware counters to every measured search
+    // --trace FILE / --trace-folded FILE record trace scopes and write them as Chrome JSON /
+    // folded stacks when the run ends
+    bool benchMode = false;
+    std::string traceChromePath, traceFoldedPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        benchMode = benchMode || arg == "--bench";
+        if (arg == "--counters") SetPerfCountersEnabled(true);
+        if (arg == "--trace" || arg == "--trace-folded") {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return 1;
+            }
+            (arg == "--trace" ? traceChromePath : traceFoldedPath) = argv[++i];
+            SetTracingEnabled(true);
+        }
+    }
+    if (benchMode) {
+        TBenchConfig config;
+        std::string error;
+        if (!ParseBenchArgs(argc, argv, config, error)) {
+            std::cerr << error << "\nUsage: " << argv[0] << " --bench [--sizes 1000,10000] [--dist random,sorted,reverse,nearly,fewunique,dupnames]"
+                      << " [--warmup N] [--reps N] [--format csv|json] [--out FILE] [--seed N] [--counters]"
+                      << " [--trace FILE] [--trace-folded FILE]" << std::endl;
+            return 1;
+        }
+        int status = RunBenchmarks(config);
+        if (TracingEnabled() && !WriteTraceFiles(traceChromePath, traceFoldedPath)) status = 1;
+        return status;
+    }
+
     std::cout << "=== TLinkedList Large-Scale Performance Analysis ===" << std::endl;
     std::cout << "FINAL REPORT: Performance metrics demonstrate O(n) complexity" << std::endl;
     std::cout << "and compare generic vs specific search function flexibility" << std::endl;
     
-    // Initialize random number generator
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // Initialize random number generator (seeded, so every run builds the same accounts)
+    TXoshiro256 gen(DEFAULT_SEED);
     
     // Create data structures
     TLinkedList<TBankAccount> accountList(true); // List will own and delete the objects
@@ -522,19 +2327,19 @@ int main() {
     
     // Generate about 600-800 unique names to create 5000+ accounts
     for (int i = 0; i < 700 && arraySize < maxAccounts; i++) {
-        std::string firstName = firstNames[nameFirstDis(gen)];
-        std::string lastName = lastNames[nameLastDis(gen)];
+        const std::string& firstName = firstNames[nameFirstDis(gen)];
+        const std::string& lastName = lastNames[nameLastDis(gen)];
         uniqueNames.push_back({firstName, lastName});
         
         // Create 5-10 accounts for this name
         int accountsForThisName = accountsPerNameDis(gen);
         for (int j = 0; j < accountsForThisName && arraySize < maxAccounts; j++) {
-            std::string accountNumber = GenerateAccountNumber(gen);
+            TAccountNumber accountNumber = GenerateAccountNumber(gen);
             EBankAccountType accountType = GenerateRandomAccountType(gen);
             time_t timestamp = GenerateRandomTimestamp(gen);
             
             TBankAccount* account = new TBankAccount(accountNumber, accountType, 
-                                                   firstName, lastName, timestamp);
+                                                   firstName, lastName, timestamp, gen);
             
             // Add to both list and array
             accountList.add(account);
@@ -558,7 +2363,7 @@ int main() {
         TBankAccount* account = *it;
         if (account) {
             std::cout << "Account: " << account->accountNumber 
-                        << ", Owner: " << account->ownerFirstName << " " << account->ownerLastName
+                        << ", Owner: " << account->OwnerFirstName() << " " << account->OwnerLastName()
                         << ", Type: " << static_cast<int>(account->accountType)
                         << ", Balance: $" << account->balance << std::endl;
         }
@@ -575,13 +2380,15 @@ int main() {
     
     if (foundAccount) {
         std::cout << "Found account " << foundAccount->accountNumber 
-                    << " belonging to: " << foundAccount->ownerFirstName 
-                    << " " << foundAccount->ownerLastName << std::endl;
+                    << " belonging to: " << foundAccount->OwnerFirstName() 
+                    << " " << foundAccount->OwnerLastName() << std::endl;
     } else {
         std::cout << "Account not found" << std::endl;
     }
     std::cout << "Search performance: " << summary.comparisons 
                 << " comparisons, " << summary.timeSpentMs << " ms" << std::endl;
+    std::cout << "Measured: " << summary.timeSpentNs << " ns, " << summary.bytesAllocated << " bytes allocated, "
+                << FormatPerfCounters(summary.counters) << std::endl;
     
     // FINAL REPORT: O(n) Analysis - Early termination demonstrates best-case performance
     std::cout << "ANALYSIS: Found at position ~" << summary.comparisons 
@@ -603,12 +2410,14 @@ int main() {
         TBankAccount* account = *it;
         if (account) {
             std::cout << "  " << account->accountNumber 
-                        << " - " << account->ownerFirstName 
-                        << " " << account->ownerLastName << std::endl;
+                        << " - " << account->OwnerFirstName() 
+                        << " " << account->OwnerLastName() << std::endl;
         }
     }
     std::cout << "Search performance: " << everySummary.comparisons 
                 << " comparisons, " << everySummary.timeSpentMs << " ms" << std::endl;
+    std::cout << "Measured: " << everySummary.timeSpentNs << " ns, " << everySummary.bytesAllocated << " bytes allocated, "
+                << FormatPerfCounters(everySummary.counters) << std::endl;
     
     // FINAL REPORT: Every() Method Analysis
     std::cout << "\nFINAL REPORT - Every() Method Characteristics:" << std::endl;
@@ -617,6 +2426,18 @@ int main() {
     std::cout << "- Generic callback approach enables flexible search criteria" << std::endl;
     std::cout << "- Returns new data structure for further processing" << std::endl;
     
+    // Test Every by last name; the name is resolved to its dictionary id once, outside the scan
+    SearchSummary lastNameSummary;
+    uint32_t searchLastNameId = NameDictionary().Intern(accountArray[0]->OwnerLastName());
+    TLinkedList<TBankAccount>* sameLastName = accountList.Every(CompareByLastName, &searchLastNameId, lastNameSummary);
+    std::cout << "\nFound " << sameLastName->getSize() << " accounts with last name "
+                << NameDictionary().Name(searchLastNameId) << " in " << lastNameSummary.comparisons
+                << " integer comparisons, " << lastNameSummary.timeSpentMs << " ms" << std::endl;
+    std::cout << "Names are stored as dictionary ids: sizeof(TBankAccount) = " << sizeof(TBankAccount)
+                << " bytes (" << sizeof(TBankAccount) - 2 * sizeof(uint32_t) + 2 * sizeof(std::string)
+                << " with two std::string names), " << NameDictionary().Size() << " distinct names" << std::endl;
+    delete sameLastName;
+    
     // Test Every by minimum balance
     SearchSummary balanceSummary;
     double minBalance = 500.0;
@@ -650,8 +2471,8 @@ int main() {
     
     if (arrayFoundAccount) {
         std::cout << "Array search found account " << arrayFoundAccount->accountNumber 
-                    << " belonging to: " << arrayFoundAccount->ownerFirstName 
-                    << " " << arrayFoundAccount->ownerLastName << std::endl;
+                    << " belonging to: " << arrayFoundAccount->OwnerFirstName() 
+                    << " " << arrayFoundAccount->OwnerLastName() << std::endl;
     } else {
         std::cout << "Array search: Account not found" << std::endl;
     }
@@ -700,6 +2521,219 @@ int main() {
     // Clean up the array (but not the data - list owns it)
     delete[] accountArray;
         
+    // Account number lookups: the old std::string layout against the packed 64-bit key.
+    // The key is absent, so every method scans all accounts.
+    {
+        const size_t lookupCount = 1000000;
+        std::cout << "\n--- Account Number Lookup (" << lookupCount << " accounts, absent key) ---" << std::endl;
+        TAccountColumns columns;
+        GenerateAccountsBulk(columns, lookupCount, DEFAULT_SEED);
+        TLinkedList<TBankAccount> lookupList(true);
+        std::vector<TBankAccount*> lookupArray(lookupCount);
+        std::vector<std::string> textNumbers(lookupCount); // What every account used to store
+        std::vector<TAccountNumber> packedNumbers(lookupCount);
+        for (size_t i = 0; i < lookupCount; i++) {
+            lookupArray[i] = columns.Materialize(i);
+            lookupList.add(lookupArray[i]);
+            textNumbers[i] = lookupArray[i]->accountNumber.ToString();
+            packedNumbers[i] = lookupArray[i]->accountNumber;
+        }
+        const char* missingNumber = "ACC000001"; // Generated numbers are 100000-999999
+        TAccountNumber missingKey(missingNumber);
+        std::cout << "Method\t\t\t\tComparisons\tTime(ms)" << std::endl;
+
+        SearchSummary textSummary;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < lookupCount; i++) {
+            textSummary.comparisons++;
+            if (textNumbers[i] == std::string(missingNumber)) break; // The old CompareByAccountNumber
+        }
+        textSummary.timeSpentMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << "std::string column (old type)\t" << textSummary.comparisons << "\t\t" << textSummary.timeSpentMs << std::endl;
+
+        SearchSummary packedSummary;
+        start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < lookupCount; i++) {
+            packedSummary.comparisons++;
+            if (packedNumbers[i] == missingKey) break;
+        }
+        packedSummary.timeSpentMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << "TAccountNumber column\t\t" << packedSummary.comparisons << "\t\t" << packedSummary.timeSpentMs << std::endl;
+
+        SearchSummary parsedSummary, keySummary, arraySummary;
+        lookupList.Find(CompareByAccountNumber, const_cast<char*>(missingNumber), parsedSummary);
+        std::cout << "Find(), const char* key\t\t" << parsedSummary.comparisons << "\t\t" << parsedSummary.timeSpentMs << std::endl;
+        lookupList.Find(CompareByAccountKey, &missingKey, keySummary);
+        std::cout << "Find(), TAccountNumber key\t" << keySummary.comparisons << "\t\t" << keySummary.timeSpentMs << std::endl;
+        FindAccountByNumber(lookupArray.data(), (int)lookupCount, missingKey, arraySummary);
+        std::cout << "FindAccountByNumber(), packed\t" << arraySummary.comparisons << "\t\t" << arraySummary.timeSpentMs << std::endl;
+
+        // Hash index on the packed key: build once, then O(1) lookups
+        start = std::chrono::high_resolution_clock::now();
+        std::unordered_map<TAccountNumber, TBankAccount*, TAccountNumberHash> index;
+        index.reserve(lookupCount);
+        for (TBankAccount* account : lookupArray) index.emplace(account->accountNumber, account);
+        double buildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        TAccountNumber presentKey = lookupArray[lookupCount / 2]->accountNumber;
+        start = std::chrono::high_resolution_clock::now();
+        bool present = index.count(presentKey) == 1 && index.count(missingKey) == 0;
+        double lookupMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << "Hash index: build " << buildMs << " ms, two lookups " << lookupMs << " ms ("
+                  << (present ? "correct" : "wrong") << "), sizeof(TAccountNumber) = " << sizeof(TAccountNumber)
+                  << " bytes vs " << sizeof(std::string) << " for std::string" << std::endl;
+    }
+
+    // Bulk generation: heap objects one at a time vs the columnar generator
+    std::cout << "\n--- Bulk Account Generation (seed " << DEFAULT_SEED << ") ---" << std::endl;
+    {
+        const size_t objectCount = 200000;
+        const size_t bulkCount = 4000000;
+        std::cout << "Method\t\t\tRows\tTime(ms)\tRows/s" << std::endl;
+
+        auto start = std::chrono::steady_clock::now();
+        TXoshiro256 objectGen(DEFAULT_SEED);
+        std::vector<TBankAccount*> objects;
+        objects.reserve(objectCount);
+        for (size_t i = 0; i < objectCount; i++) {
+            objects.push_back(new TBankAccount(GenerateAccountNumber(objectGen),
+                                               GenerateRandomAccountType(objectGen),
+                                               firstNames[objectGen.NextBelow((uint32_t)firstNames.size())],
+                                               lastNames[objectGen.NextBelow((uint32_t)lastNames.size())],
+                                               GenerateRandomTimestamp(objectGen), objectGen));
+        }
+        double objectMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "TBankAccount objects\t" << objectCount << "\t" << objectMs
+                  << "\t" << objectCount / (objectMs / 1000.0) << std::endl;
+        for (TBankAccount* account : objects) delete account;
+
+        TAccountColumns single, parallel;
+        start = std::chrono::steady_clock::now();
+        GenerateAccountsBulk(single, bulkCount, DEFAULT_SEED, 1);
+        double singleMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Columnar, 1 thread\t" << bulkCount << "\t" << singleMs
+                  << "\t" << bulkCount / (singleMs / 1000.0) << std::endl;
+
+        // At least 4 threads so the determinism check below also means something on small machines
+        unsigned threadCount = std::max(4u, std::thread::hardware_concurrency());
+        start = std::chrono::steady_clock::now();
+        GenerateAccountsBulk(parallel, bulkCount, DEFAULT_SEED, threadCount);
+        double parallelMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Columnar, " << threadCount << " threads\t" << bulkCount << "\t" << parallelMs
+                  << "\t" << bulkCount / (parallelMs / 1000.0) << std::endl;
+
+        bool identical = single.accountNumbers == parallel.accountNumbers &&
+                         single.creationTimestamps == parallel.creationTimestamps &&
+                         single.balances == parallel.balances;
+        std::cout << "Same rows for 1 and " << threadCount << " threads: " << (identical ? "Yes" : "No") << std::endl;
+
+        TBankAccount* sample = single.Materialize(0);
+        std::cout << "Row 0: " << sample->accountNumber << " - " << sample->OwnerFirstName() << " "
+                  << sample->OwnerLastName() << ", $" << sample->balance << std::endl;
+        delete sample;
+
+        // Persist the bulk rows once, then reopen them through the memory-mapped file
+        std::cout << "\n--- Binary Account File (mmap) ---" << std::endl;
+        std::string path = (std::filesystem::temp_directory_path() / "assignment4_accounts.bin").string();
+        try {
+            start = std::chrono::steady_clock::now();
+            WriteAccountFile(path, single);
+            double writeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            start = std::chrono::steady_clock::now();
+            TMappedAccountFile mapped(path);
+            double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            start = std::chrono::steady_clock::now();
+            double balanceSum = 0.0;
+            const double* balances = mapped.Balances();
+            for (size_t row = 0; row < mapped.Size(); row++) balanceSum += balances[row];
+            double scanMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            size_t mismatches = 0;
+            for (size_t row = 0; row < mapped.Size(); row++) {
+                if (mapped.AccountNumber(row) != single.AccountNumber(row).ToString() ||
+                    mapped.FirstName(row) != firstNames[single.firstNameIds[row]] ||
+                    mapped.LastName(row) != lastNames[single.lastNameIds[row]] ||
+                    mapped.CreationTimestamp(row) != single.creationTimestamps[row] ||
+                    mapped.Balance(row) != single.balances[row] ||
+                    static_cast<uint8_t>(mapped.AccountType(row)) != single.accountTypes[row]) {
+                    mismatches++;
+                }
+            }
+
+            SearchSummary mappedSummary;
+            std::string lastNumber = single.AccountNumber(single.Size() - 1).ToString();
+            long long row = mapped.FindRow(lastNumber, mappedSummary);
+
+            std::cout << "Rows: " << mapped.Size() << ", file size: "
+                      << std::filesystem::file_size(path) / (1024.0 * 1024.0) << " MB" << std::endl;
+            std::cout << "Write: " << writeMs << " ms, open (map + validate): " << openMs
+                      << " ms, regenerate: " << singleMs << " ms" << std::endl;
+            std::cout << "Balance column scan: " << scanMs << " ms (sum $" << balanceSum << ")" << std::endl;
+            std::cout << "Round-trip mismatches: " << mismatches << std::endl;
+            std::cout << "FindRow(" << lastNumber << ") -> row " << row << ", " << mappedSummary.comparisons
+                      << " comparisons, " << mappedSummary.timeSpentMs << " ms" << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "Account file demo failed: " << e.what() << std::endl;
+        }
+        std::remove(path.c_str());
+
+        // Stream part of the bulk rows back in through the CSV ingest pipeline
+        std::cout << "\n--- Streaming CSV Ingest ---" << std::endl;
+        const size_t csvRows = 1000000;
+        std::string csvPath = (std::filesystem::temp_directory_path() / "assignment4_accounts.csv").string();
+        try {
+            WriteAccountCsv(csvPath, single, csvRows);
+            std::cout << "Parsers\tRows\tBad\tChunks\tTime(ms)\tMB/s\tRows/s\t\tIn order" << std::endl;
+            for (unsigned parsers : { 1u, threadCount }) {
+                size_t expectedRow = 0;
+                size_t mismatches = 0;
+                IngestSummary ingest = IngestAccountCsv(csvPath, [&](const TCsvAccountRow& row) {
+                    if (expectedRow >= csvRows || row.balance != single.balances[expectedRow] ||
+                        row.creationTimestamp != single.creationTimestamps[expectedRow]) {
+                        mismatches++;
+                    }
+                    expectedRow++;
+                }, parsers);
+                std::cout << parsers << "\t" << ingest.rows << "\t" << ingest.badRows << "\t" << ingest.chunks
+                          << "\t" << ingest.timeSpentMs << "\t" << ingest.MegabytesPerSecond() << "\t"
+                          << ingest.RowsPerSecond() << "\t" << (mismatches == 0 && expectedRow == csvRows ? "Yes" : "No")
+                          << std::endl;
+            }
+
+            // Ingest straight into a TLinkedList, as main's random loop populates one; a small window
+            // keeps at most 4 chunks of text alive while the list allocates
+            TLinkedList<TBankAccount> csvList(true);
+            IngestSummary listIngest = IngestAccountCsv(csvPath, [&](const TCsvAccountRow& row) {
+                csvList.add(new TBankAccount(row.accountNumber, row.accountType, std::string(row.firstName),
+                                             std::string(row.lastName), row.creationTimestamp, row.balance));
+            }, threadCount, 1 << 20, 4);
+            std::cout << "Into TLinkedList: " << csvList.getSize() << " accounts, " << listIngest.timeSpentMs
+                      << " ms, " << listIngest.RowsPerSecond() << " rows/s" << std::endl;
+
+            // Malformed account numbers (non-digit, too many digits) are skipped and counted,
+            // not thrown from the sink
+            {
+                std::ofstream badCsv(csvPath, std::ios::trunc);
+                badCsv << ACCOUNT_CSV_HEADER << "\n"
+                       << "ACC100001,Checking,Ada,Lovelace,1700000000,12.5\n"
+                       << "ACC12X,Savings,Alan,Turing,1700000000,1\n"
+                       << "ACC123456789012345,Savings,Grace,Hopper,1700000000,1\n"
+                       << "ACC100002,Loan,Edsger,Dijkstra,1700000000,-30000\n";
+            }
+            TLinkedList<TBankAccount> checkedList(true);
+            IngestSummary checked = IngestAccountCsv(csvPath, [&](const TCsvAccountRow& row) {
+                checkedList.add(new TBankAccount(row.accountNumber, row.accountType, std::string(row.firstName),
+                                                 std::string(row.lastName), row.creationTimestamp, row.balance));
+            }, 1);
+            std::cout << "Malformed account numbers: " << checkedList.getSize() << " accounts loaded, "
+                      << checked.badRows << " bad rows (expected 2 and 2)" << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "CSV ingest demo failed: " << e.what() << std::endl;
+        }
+        std::remove(csvPath.c_str());
+    }
+
     std::cout << "\nList going out of scope - automatic cleanup will occur" << std::endl;
     
     // FINAL REPORT: Memory Management Analysis
@@ -764,6 +2798,7 @@ int main() {
     std::cout << "   - Timing precision enables performance comparison" << std::endl;
 
     std::cout << "\n=== Demo completed ===" << std::endl;
+    if (TracingEnabled() && !WriteTraceFiles(traceChromePath, traceFoldedPath)) return 1;
     return 0;
 }
 
@@ -14,6 +14,30 @@
 #include <iomanip>
 #include <map>
 #include <cctype>
+#include <cstdint>
+#include <thread>
+#include <algorithm>
+#include <shared_mutex>
+#include <mutex>
+#include <string_view>
+#include <deque>
+#include <cstring>
+#include <unordered_map>
+#include <stdexcept>
+#include <fstream>
+#include <atomic>
+#include <memory>
+#include <cstdlib>
+#include <new>
+
+// Hardware performance counters for the measured scopes; other platforms report them as unavailable
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PERF_COUNTERS_HAS_PERF_EVENT 1
+#endif
 
 enum class EBankAccountType { Checking, Savings, Credit, Pension, Loan };
 
@@ -25,50 +49,743 @@ class TBankAccount;
 typedef int (*FCompareAccounts)(TBankAccount* a, TBankAccount* b);
 
 // OperationSummary struct to track performance metrics
+// Hardware counter deltas for one measured scope; -1 when a counter is unavailable (counters
+// disabled, non-Linux build, or perf_event_open refused by the kernel or hypervisor)
+struct PerfCounters {
+	long long cycles;
+	long long instructions;
+	long long cacheMisses;
+	long long branchMisses;
+
+	PerfCounters() : cycles(-1), instructions(-1), cacheMisses(-1), branchMisses(-1) {}
+};
+
 struct OperationSummary {
 	long long comparisons;
 	long long swaps;
 	double timeSpentMs;
-	OperationSummary() : comparisons(0), swaps(0), timeSpentMs(0.0) {}
+	long long timeSpentNs;    // steady_clock nanoseconds; timeSpentMs is derived from it
+	long long bytesAllocated; // Bytes requested from operator new on the sorting thread
+	PerfCounters counters;    // Hardware counters, when enabled
+	OperationSummary() : comparisons(0), swaps(0), timeSpentMs(0.0), timeSpentNs(0), bytesAllocated(0) {}
+};
+
+// Bytes requested from operator new on the current thread since it started. Counted always, at
+// one thread-local add per allocation. Every plain/array/nothrow form is replaced so each
+// allocation is counted and paired with the matching delete; aligned forms are left to the library.
+thread_local long long threadBytesAllocated = 0;
+
+// Allocation and release are kept out of line: if GCC inlines free() into a replaced operator
+// delete it pairs it with operator new and reports -Wmismatched-new-delete at every call site
+#if defined(__GNUC__)
+#define ALLOCATION_NOINLINE __attribute__((noinline))
+#else
+#define ALLOCATION_NOINLINE
+#endif
+
+ALLOCATION_NOINLINE void* CountedAllocate(std::size_t size) noexcept {
+	void* memory = std::malloc(size ? size : 1);
+	if (memory) threadBytesAllocated += (long long)size;
+	return memory;
+}
+
+ALLOCATION_NOINLINE void CountedFree(void* memory) noexcept { std::free(memory); }
+
+// Retries through the installed new_handler before giving up, as the standard operator new does
+void* operator new(std::size_t size) {
+	for (;;) {
+		if (void* memory = CountedAllocate(size)) return memory;
+		std::new_handler handler = std::get_new_handler();
+		if (!handler) throw std::bad_alloc();
+		handler();
+	}
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	try { return operator new(size); } catch (const std::bad_alloc&) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	try { return operator new(size); } catch (const std::bad_alloc&) { return nullptr; }
+}
+void operator delete(void* memory) noexcept { CountedFree(memory); }
+void operator delete[](void* memory) noexcept { CountedFree(memory); }
+void operator delete(void* memory, std::size_t) noexcept { CountedFree(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { CountedFree(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { CountedFree(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { CountedFree(memory); }
+
+// Hardware counters are off by default (--counters turns them on): each measured scope then
+// costs two read() system calls
+std::atomic<bool>& PerfCountersFlag() {
+	static std::atomic<bool> enabled(false);
+	return enabled;
+}
+
+bool PerfCountersEnabled() { return PerfCountersFlag().load(std::memory_order_relaxed); }
+void SetPerfCountersEnabled(bool enabled) { PerfCountersFlag().store(enabled, std::memory_order_relaxed); }
+
+// One perf_event group per thread (cycles leads; instructions, cache misses and branch misses
+// follow), opened on first use and left running; scopes take deltas of group reads, so they nest.
+// User-space only, which unprivileged processes are allowed to count.
+class TPerfCounterGroup {
+private:
+	static const int COUNTER_COUNT = 4;
+	int fds[COUNTER_COUNT];
+	int slots[COUNTER_COUNT]; // Position of each counter in a group read, -1 if it did not open
+	int openCount;
+
+public:
+	TPerfCounterGroup() : openCount(0) {
+		for (int i = 0; i < COUNTER_COUNT; i++) { fds[i] = -1; slots[i] = -1; }
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+		const uint64_t configs[COUNTER_COUNT] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+												  PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+		for (int i = 0; i < COUNTER_COUNT; i++) {
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = configs[i];
+			attr.read_format = PERF_FORMAT_GROUP;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			int leader = openCount == 0 ? -1 : fds[0];
+			int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+			if (fd < 0) {
+				if (i == 0) return; // Without cycles there is no group to read
+				continue;
+			}
+			fds[i] = fd;
+			slots[i] = openCount++;
+		}
+#endif
+	}
+
+	~TPerfCounterGroup() {
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+		for (int i = 0; i < COUNTER_COUNT; i++) if (fds[i] >= 0) close(fds[i]);
+#endif
+	}
+
+	TPerfCounterGroup(const TPerfCounterGroup&) = delete;
+	TPerfCounterGroup& operator=(const TPerfCounterGroup&) = delete;
+
+	static TPerfCounterGroup& ForThisThread() {
+		thread_local TPerfCounterGroup group;
+		return group;
+	}
+
+	// Current running totals, -1 for counters that did not open; false if nothing could be read
+	bool Read(long long values[COUNTER_COUNT]) const {
+		for (int i = 0; i < COUNTER_COUNT; i++) values[i] = -1;
+#ifdef PERF_COUNTERS_HAS_PERF_EVENT
+		if (openCount == 0) return false;
+		uint64_t buffer[1 + COUNTER_COUNT];
+		if (read(fds[0], buffer, sizeof(buffer)) < (ssize_t)((1 + openCount) * sizeof(uint64_t))) return false;
+		for (int i = 0; i < COUNTER_COUNT; i++) if (slots[i] >= 0) values[i] = (long long)buffer[1 + slots[i]];
+		return true;
+#else
+		return false;
+#endif
+	}
+};
+
+// Measures the enclosing scope into a summary: steady_clock nanoseconds (and timeSpentMs from
+// them), bytes allocated on this thread and, when enabled, hardware counter deltas. Results are
+// written by Stop() or the destructor, so early returns are measured too.
+template<typename Summary>
+class TPerfScope {
+private:
+	Summary& summary;
+	bool counting;
+	bool stopped;
+	long long startBytes;
+	long long startCounters[4];
+	std::chrono::steady_clock::time_point start;
+
+public:
+	explicit TPerfScope(Summary& target)
+		: summary(target), counting(PerfCountersEnabled()), stopped(false), startBytes(threadBytesAllocated) {
+		if (counting) counting = TPerfCounterGroup::ForThisThread().Read(startCounters);
+		start = std::chrono::steady_clock::now(); // Last, so the counter read is not timed
+	}
+
+	~TPerfScope() { Stop(); }
+
+	TPerfScope(const TPerfScope&) = delete;
+	TPerfScope& operator=(const TPerfScope&) = delete;
+
+	void Stop() {
+		if (stopped) return;
+		stopped = true;
+		auto end = std::chrono::steady_clock::now();
+		summary.timeSpentNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		summary.timeSpentMs = summary.timeSpentNs / 1e6;
+		if (counting) {
+			long long endCounters[4];
+			TPerfCounterGroup::ForThisThread().Read(endCounters);
+			long long* fields[4] = { &summary.counters.cycles, &summary.counters.instructions,
+									 &summary.counters.cacheMisses, &summary.counters.branchMisses };
+			for (int i = 0; i < 4; i++) {
+				*fields[i] = (startCounters[i] < 0 || endCounters[i] < 0) ? -1 : endCounters[i] - startCounters[i];
+			}
+		}
+		summary.bytesAllocated = threadBytesAllocated - startBytes;
+	}
+};
+
+// "cycles=... instructions=... (IPC ...) cache-misses=... branch-misses=..." with n/a for
+// counters that were not measured
+std::string FormatPerfCounters(const PerfCounters& counters) {
+	auto field = [](long long value) { return value < 0 ? std::string("n/a") : std::to_string(value); };
+	std::ostringstream out;
+	out << "cycles=" << field(counters.cycles) << " instructions=" << field(counters.instructions);
+	if (counters.cycles > 0 && counters.instructions >= 0) {
+		out << " (IPC " << std::fixed << std::setprecision(2) << (double)counters.instructions / counters.cycles << ")";
+	}
+	out << " cache-misses=" << field(counters.cacheMisses) << " branch-misses=" << field(counters.branchMisses);
+	return out.str();
+}
+
+// Scoped tracing. A TTraceScope records one complete event (name, start, duration, nesting
+// depth) into a ring buffer owned by the current thread when it closes. While tracing is off
+// a scope costs one relaxed atomic load. Turn it on with SetTracingEnabled(true), or --trace /
+// --trace-folded on the command line, and export with WriteChromeTrace (chrome://tracing,
+// Perfetto) or WriteFoldedStacks (flamegraph.pl, speedscope).
+// Names must be string literals; only the pointer is stored.
+const size_t TRACE_RING_EVENTS = 1 << 16; // Per thread; the oldest events are overwritten
+
+struct TTraceEvent {
+	const char* name;
+	uint64_t startNs;    // Since the first traced event in the process
+	uint64_t durationNs;
+	uint32_t depth;      // Enclosing open scopes on the same thread
+};
+
+// Events of one thread. Only the owning thread writes; written is published with release so an
+// exporter running after the traced work has finished sees complete events.
+struct TTraceBuffer {
+	uint32_t threadId;
+	std::vector<TTraceEvent> ring;
+	std::atomic<uint64_t> written;
+
+	explicit TTraceBuffer(uint32_t id) : threadId(id), ring(TRACE_RING_EVENTS), written(0) {}
+};
+
+std::atomic<bool> tracingEnabled(false);
+
+bool TracingEnabled() { return tracingEnabled.load(std::memory_order_relaxed); }
+void SetTracingEnabled(bool enabled) { tracingEnabled.store(enabled, std::memory_order_relaxed); }
+
+// Every thread's buffer, kept alive after the thread exits so its events can still be exported
+class TTraceRegistry {
+private:
+	std::mutex mutex;
+	std::vector<std::shared_ptr<TTraceBuffer>> buffers;
+	std::chrono::steady_clock::time_point epoch;
+
+public:
+	TTraceRegistry() : epoch(std::chrono::steady_clock::now()) {}
+
+	static TTraceRegistry& Instance() {
+		static TTraceRegistry registry;
+		return registry;
+	}
+
+	uint64_t NowNs() const {
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+	}
+
+	TTraceBuffer& ThreadBuffer() {
+		thread_local std::shared_ptr<TTraceBuffer> buffer;
+		if (!buffer) {
+			std::lock_guard<std::mutex> lock(mutex);
+			buffer = std::make_shared<TTraceBuffer>((uint32_t)buffers.size() + 1);
+			buffers.push_back(buffer);
+		}
+		return *buffer;
+	}
+
+	// Snapshot of each thread's surviving events in recording order
+	std::vector<std::pair<uint32_t, std::vector<TTraceEvent>>> Snapshot() {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::vector<std::pair<uint32_t, std::vector<TTraceEvent>>> threads;
+		for (const auto& buffer : buffers) {
+			uint64_t written = buffer->written.load(std::memory_order_acquire);
+			uint64_t first = written > TRACE_RING_EVENTS ? written - TRACE_RING_EVENTS : 0;
+			std::vector<TTraceEvent> events;
+			events.reserve((size_t)(written - first));
+			for (uint64_t i = first; i < written; i++) events.push_back(buffer->ring[i % TRACE_RING_EVENTS]);
+			threads.emplace_back(buffer->threadId, std::move(events));
+		}
+		return threads;
+	}
+};
+
+thread_local uint32_t traceDepth = 0;
+
+class TTraceScope {
+private:
+	const char* name; // nullptr when tracing was off as the scope opened
+	uint64_t startNs;
+
+public:
+	explicit TTraceScope(const char* scopeName) : name(nullptr), startNs(0) {
+		if (!TracingEnabled()) return;
+		name = scopeName;
+		traceDepth++;
+		startNs = TTraceRegistry::Instance().NowNs();
+	}
+
+	~TTraceScope() {
+		if (!name) return;
+		TTraceRegistry& registry = TTraceRegistry::Instance();
+		uint64_t endNs = registry.NowNs();
+		traceDepth--;
+		TTraceBuffer& buffer = registry.ThreadBuffer();
+		uint64_t index = buffer.written.load(std::memory_order_relaxed);
+		buffer.ring[index % TRACE_RING_EVENTS] = TTraceEvent{ name, startNs, endNs - startNs, traceDepth };
+		buffer.written.store(index + 1, std::memory_order_release);
+	}
+
+	TTraceScope(const TTraceScope&) = delete;
+	TTraceScope& operator=(const TTraceScope&) = delete;
+};
+
+// Chrome trace-event JSON: one complete ("X") event per scope, timestamps in microseconds
+void WriteChromeTrace(std::ostream& out) {
+	auto threads = TTraceRegistry::Instance().Snapshot();
+	out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+	bool first = true;
+	for (const auto& thread : threads) {
+		for (const TTraceEvent& event : thread.second) {
+			out << (first ? "\n" : ",\n") << "  {\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+				<< thread.first << std::fixed << std::setprecision(3) << ", \"ts\": " << event.startNs / 1000.0
+				<< ", \"dur\": " << event.durationNs / 1000.0 << "}";
+			first = false;
+		}
+	}
+	out << "\n]}\n";
+}
+
+// Folded stacks ("outer;inner nanoseconds" per line) with self time, so a flame graph's widths
+// add up to the traced time. Stacks are rebuilt per thread from start times and depths; a scope
+// whose parent was overwritten in the ring becomes a root.
+void WriteFoldedStacks(std::ostream& out) {
+	std::map<std::string, uint64_t> selfNs;
+	for (auto& thread : TTraceRegistry::Instance().Snapshot()) {
+		std::vector<TTraceEvent>& events = thread.second;
+		// Events are recorded as scopes close (children first); order them parent first
+		std::sort(events.begin(), events.end(), [](const TTraceEvent& a, const TTraceEvent& b) {
+			return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth;
+		});
+		std::vector<std::string> paths(events.size());
+		std::vector<uint64_t> selfTime(events.size());
+		std::vector<size_t> open; // Indices of the scopes enclosing the current event
+		for (size_t i = 0; i < events.size(); i++) {
+			const TTraceEvent& event = events[i];
+			while (!open.empty() && (events[open.back()].depth >= event.depth ||
+									 events[open.back()].startNs + events[open.back()].durationNs <= event.startNs)) {
+				open.pop_back();
+			}
+			paths[i] = open.empty() ? std::string(event.name) : paths[open.back()] + ";" + event.name;
+			selfTime[i] = event.durationNs;
+			if (!open.empty()) {
+				uint64_t& parentSelf = selfTime[open.back()];
+				parentSelf -= std::min(parentSelf, event.durationNs);
+			}
+			open.push_back(i);
+		}
+		for (size_t i = 0; i < events.size(); i++) selfNs[paths[i]] += selfTime[i];
+	}
+	for (const auto& entry : selfNs) {
+		if (entry.second > 0) out << entry.first << " " << entry.second << "\n";
+	}
+}
+
+// Writes the requested trace files; an empty path skips that format
+bool WriteTraceFiles(const std::string& chromePath, const std::string& foldedPath) {
+	bool ok = true;
+	if (!chromePath.empty()) {
+		std::ofstream file(chromePath);
+		if (file) WriteChromeTrace(file);
+		ok = ok && (bool)file;
+	}
+	if (!foldedPath.empty()) {
+		std::ofstream file(foldedPath);
+		if (file) WriteFoldedStacks(file);
+		ok = ok && (bool)file;
+	}
+	if (!ok) std::cerr << "Could not write trace output" << std::endl;
+	return ok;
+}
+
+// xoshiro256** generator: 32 bytes of state and a handful of shifts per draw, so it can be
+// passed around and copied per thread instead of reseeding a std::mt19937 for every account.
+// Satisfies UniformRandomBitGenerator, so the std distributions accept it as well.
+class TXoshiro256 {
+private:
+	uint64_t state[4];
+
+	static uint64_t RotateLeft(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+	typedef uint64_t result_type;
+
+	explicit TXoshiro256(uint64_t seed = 0) { Seed(seed); }
+
+	// Expands a 64-bit seed into the full state so similar seeds still give unrelated streams
+	void Seed(uint64_t seed) {
+		for (int i = 0; i < 4; i++) state[i] = SplitMix64(seed);
+	}
+
+	// splitmix64 step: advances x and returns a well-mixed 64-bit value
+	static uint64_t SplitMix64(uint64_t& x) {
+		uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT64_MAX; }
+
+	result_type operator()() {
+		uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+		uint64_t t = state[1] << 17;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = RotateLeft(state[3], 45);
+		return result;
+	}
+
+	// Uniform integer in [0, bound) by multiply-shift instead of a modulo
+	uint32_t NextBelow(uint32_t bound) {
+		return (uint32_t)(((*this)() >> 32) * bound >> 32);
+	}
+
+	// Uniform double in [low, high) from the top 53 bits
+	double NextDouble(double low, double high) {
+		return low + (high - low) * ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+	}
+};
+
+// Per-thread generator for callers that do not pass one; seeded once from random_device
+TXoshiro256& ThreadLocalGenerator() {
+	thread_local TXoshiro256 gen(((uint64_t)std::random_device{}() << 32) ^ std::random_device{}());
+	return gen;
+}
+
+// Random opening balance for an account type (loans and credit start negative)
+double GenerateBalance(EBankAccountType accountType, TXoshiro256& gen) {
+	switch (accountType) {
+		case EBankAccountType::Loan:     return gen.NextDouble(-50000.0, -25000.0);
+		case EBankAccountType::Credit:   return gen.NextDouble(-1000.0, 0.0);
+		case EBankAccountType::Checking:
+		case EBankAccountType::Savings:
+		case EBankAccountType::Pension:  return gen.NextDouble(0.0, 1000.0);
+	}
+	return 0.0;
+}
+
+// Interns owner names to 32-bit ids so accounts store two ids instead of two strings.
+// Ids are handed out in string order with gaps left between neighbours, so comparing two ordered
+// ids gives the same answer as comparing the names. A name interned later takes the midpoint of
+// the gap around it; if that gap is used up it gets an id with UNORDERED_BIT set and comparisons
+// involving it fall back to the strings. Equal names always share one id. Thread-safe.
+class TNameDictionary {
+private:
+	mutable std::shared_mutex mutex;
+	std::map<std::string, uint32_t, std::less<>> idsByName; // Sorted, so neighbours are one step away
+	std::unordered_map<uint32_t, const std::string*> namesById; // Points at the map's keys
+	uint32_t nextUnorderedId;
+
+	// Nearest ordered id on each side of position; 0 and UNORDERED_BIT bound the range
+	uint32_t OrderedIdBefore(std::map<std::string, uint32_t, std::less<>>::const_iterator position) const {
+		while (position != idsByName.begin()) {
+			--position;
+			if (IsOrdered(position->second)) return position->second;
+		}
+		return 0;
+	}
+
+	uint32_t OrderedIdFrom(std::map<std::string, uint32_t, std::less<>>::const_iterator position) const {
+		for (; position != idsByName.end(); ++position) {
+			if (IsOrdered(position->second)) return position->second;
+		}
+		return UNORDERED_BIT;
+	}
+
+	uint32_t Insert(std::string_view name, uint32_t id) {
+		auto inserted = idsByName.emplace(std::string(name), id).first;
+		namesById.emplace(id, &inserted->first);
+		return id;
+	}
+
+public:
+	static constexpr uint32_t INVALID_ID = 0;
+	static constexpr uint32_t UNORDERED_BIT = 0x80000000u;
+
+	// Spreads the distinct catalogue names evenly over the ordered id range
+	explicit TNameDictionary(const std::vector<std::string>& catalogue = {}) : nextUnorderedId(1) {
+		std::vector<std::string> sorted(catalogue);
+		std::sort(sorted.begin(), sorted.end());
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+		uint32_t spacing = (uint32_t)((UNORDERED_BIT - 1) / (sorted.size() + 1));
+		for (size_t i = 0; i < sorted.size(); i++) Insert(sorted[i], (uint32_t)(spacing * (i + 1)));
+	}
+
+	TNameDictionary(const TNameDictionary&) = delete;
+	TNameDictionary& operator=(const TNameDictionary&) = delete;
+
+	static bool IsOrdered(uint32_t id) { return (id & UNORDERED_BIT) == 0; }
+
+	// Returns the id of name, adding it if needed
+	// Time: O(log n) string comparisons, Space: O(1) per new name
+	uint32_t Intern(std::string_view name) {
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			auto it = idsByName.find(name);
+			if (it != idsByName.end()) return it->second;
+		}
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		auto position = idsByName.lower_bound(name);
+		if (position != idsByName.end() && position->first == name) return position->second; // Raced with another Intern
+		uint32_t low = OrderedIdBefore(position);
+		uint32_t high = OrderedIdFrom(position);
+		if (high - low > 1) return Insert(name, low + (high - low) / 2);
+		return Insert(name, UNORDERED_BIT | nextUnorderedId++);
+	}
+
+	// Looks name up without adding it; returns false if it was never interned
+	bool Find(std::string_view name, uint32_t& id) const {
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		auto it = idsByName.find(name);
+		if (it == idsByName.end()) return false;
+		id = it->second;
+		return true;
+	}
+
+	// Name for an interned id; throws std::out_of_range for unknown ids
+	const std::string& Name(uint32_t id) const {
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		auto it = namesById.find(id);
+		if (it == namesById.end()) throw std::out_of_range("Unknown name id");
+		return *it->second;
+	}
+
+	// Negative, zero or positive like std::string::compare; integer-only when both ids are ordered
+	// Time: O(1) for ordered ids, Space: O(1)
+	int Compare(uint32_t a, uint32_t b) const {
+		if (a == b) return 0;
+		if (IsOrdered(a) && IsOrdered(b)) return a < b ? -1 : 1;
+		return Name(a).compare(Name(b));
+	}
+
+	size_t Size() const {
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		return idsByName.size();
+	}
+};
+
+// Dictionary shared by every TBankAccount; seeded with the firstNames/lastNames catalogue
+TNameDictionary& NameDictionary();
+
+// Registry of account number prefixes ("ACC", ...) so a packed number stores a small id, not text
+class TAccountPrefixTable {
+private:
+	mutable std::shared_mutex mutex;
+	std::deque<std::string> prefixes; // deque keeps references valid as prefixes are added
+
+public:
+	static constexpr uint32_t MAX_PREFIXES = 4096; // Ids must fit in 12 bits
+
+	TAccountPrefixTable() { prefixes.emplace_back("ACC"); } // ACC_PREFIX_ID
+
+	// Returns false if prefix is new and the table is full
+	bool Intern(std::string_view prefix, uint32_t& id) {
+		if (Find(prefix, id)) return true;
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		for (size_t i = 0; i < prefixes.size(); i++) {
+			if (prefixes[i] == prefix) { id = (uint32_t)i; return true; } // Raced with another Intern
+		}
+		if (prefixes.size() == MAX_PREFIXES) return false;
+		id = (uint32_t)prefixes.size();
+		prefixes.emplace_back(prefix);
+		return true;
+	}
+
+	// Looks prefix up without adding it (a handful of prefixes, so a linear scan)
+	bool Find(std::string_view prefix, uint32_t& id) const {
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		for (size_t i = 0; i < prefixes.size(); i++) {
+			if (prefixes[i] == prefix) { id = (uint32_t)i; return true; }
+		}
+		return false;
+	}
+
+	const std::string& Prefix(uint32_t id) const {
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		if (id >= prefixes.size()) throw std::out_of_range("Unknown account number prefix id");
+		return prefixes[id];
+	}
+};
+
+// Prefix table shared by every account number
+TAccountPrefixTable& AccountPrefixes() {
+	static TAccountPrefixTable table;
+	return table;
+}
+
+const uint32_t ACC_PREFIX_ID = 0; // "ACC", registered when the table is created
+
+// Account number such as "ACC123456" packed into 64 bits:
+// prefix id (12 bits) | digit count (4 bits) | numeric part (48 bits).
+// The digit count keeps leading zeros, so "ACC003" and "ACC3" stay different numbers.
+// Equality, hashing and ordering work on Key() alone; text only appears at the I/O boundary
+// through Parse/Lookup and ToString. Keys order by prefix id, then length, then value.
+class TAccountNumber {
+private:
+	uint64_t packed;
+
+	static constexpr int NUMBER_BITS = 48;
+	static constexpr int DIGIT_BITS = 4;
+	static constexpr uint64_t NUMBER_MASK = (1ULL << NUMBER_BITS) - 1;
+
+	// Splits text into a letter prefix and 1..MAX_DIGITS digits
+	static bool Split(std::string_view text, std::string_view& prefix, uint64_t& number, uint32_t& digits) {
+		size_t firstDigit = 0;
+		while (firstDigit < text.size() && !std::isdigit((unsigned char)text[firstDigit])) firstDigit++;
+		digits = (uint32_t)(text.size() - firstDigit);
+		if (digits == 0 || digits > MAX_DIGITS) return false;
+		number = 0;
+		for (size_t i = firstDigit; i < text.size(); i++) {
+			if (!std::isdigit((unsigned char)text[i])) return false;
+			number = number * 10 + (uint64_t)(text[i] - '0');
+		}
+		prefix = text.substr(0, firstDigit);
+		return true;
+	}
+
+public:
+	static constexpr uint32_t MAX_DIGITS = 14; // 10^14 - 1 still fits in 48 bits
+
+	TAccountNumber() : packed(0) {}
+	TAccountNumber(uint32_t prefixId, uint32_t digits, uint64_t number)
+		: packed((uint64_t)prefixId << (NUMBER_BITS + DIGIT_BITS) | (uint64_t)digits << NUMBER_BITS | (number & NUMBER_MASK)) {}
+
+	// Implicit from text so existing call sites keep passing strings; throws std::invalid_argument
+	// for text that is not a prefix followed by 1..MAX_DIGITS digits
+	TAccountNumber(std::string_view text) : packed(0) {
+		if (!Parse(text, *this)) throw std::invalid_argument("Invalid account number: " + std::string(text));
+	}
+	TAccountNumber(const std::string& text) : TAccountNumber(std::string_view(text)) {}
+	TAccountNumber(const char* text) : TAccountNumber(std::string_view(text)) {}
+
+	// Parses text, registering its prefix if new; returns false for malformed text
+	static bool Parse(std::string_view text, TAccountNumber& out) {
+		std::string_view prefix;
+		uint64_t number;
+		uint32_t digits, prefixId;
+		if (!Split(text, prefix, number, digits)) return false;
+		if (prefix == "ACC") prefixId = ACC_PREFIX_ID; // Common case, skips the table lock
+		else if (!AccountPrefixes().Intern(prefix, prefixId)) return false;
+		out = TAccountNumber(prefixId, digits, number);
+		return true;
+	}
+
+	// Parses a search key without registering anything; false also means no account can match
+	static bool Lookup(std::string_view text, TAccountNumber& out) {
+		std::string_view prefix;
+		uint64_t number;
+		uint32_t digits, prefixId;
+		if (!Split(text, prefix, number, digits)) return false;
+		if (prefix == "ACC") prefixId = ACC_PREFIX_ID; // Common case, skips the table lock
+		else if (!AccountPrefixes().Find(prefix, prefixId)) return false;
+		out = TAccountNumber(prefixId, digits, number);
+		return true;
+	}
+
+	uint64_t Key() const { return packed; }
+	uint32_t PrefixId() const { return (uint32_t)(packed >> (NUMBER_BITS + DIGIT_BITS)); }
+	uint32_t Digits() const { return (uint32_t)(packed >> NUMBER_BITS) & ((1u << DIGIT_BITS) - 1); }
+	uint64_t Number() const { return packed & NUMBER_MASK; }
+
+	std::string ToString() const {
+		std::string digits = std::to_string(Number());
+		if (digits.size() < Digits()) digits.insert(0, Digits() - digits.size(), '0');
+		return AccountPrefixes().Prefix(PrefixId()) + digits;
+	}
+
+	bool operator==(const TAccountNumber& other) const { return packed == other.packed; }
+	bool operator!=(const TAccountNumber& other) const { return packed != other.packed; }
+	bool operator<(const TAccountNumber& other) const { return packed < other.packed; }
+};
+
+std::ostream& operator<<(std::ostream& out, const TAccountNumber& accountNumber) {
+	return out << accountNumber.ToString();
+}
+
+// Hash functor for unordered containers keyed by account number
+struct TAccountNumberHash {
+	size_t operator()(const TAccountNumber& accountNumber) const { return std::hash<uint64_t>()(accountNumber.Key()); }
 };
 
 class TBankAccount {
 public:
-	std::string accountNumber;
+	TAccountNumber accountNumber;   // Packed; strings convert implicitly
 	EBankAccountType accountType;
-	std::string ownerFirstName;
-	std::string ownerLastName;
+	uint32_t ownerFirstNameId;  // Id in NameDictionary()
+	uint32_t ownerLastNameId;   // Id in NameDictionary()
 	time_t creationTimestamp;
 	double balance;
 
-	TBankAccount(const std::string& accountNumber,
+	TBankAccount(TAccountNumber accountNumber,
 				 EBankAccountType accountType,
 				 const std::string& ownerFirstName,
 				 const std::string& ownerLastName,
 				 time_t creationTimestamp)
 		: accountNumber(accountNumber),
 		  accountType(accountType),
-		  ownerFirstName(ownerFirstName),
-		  ownerLastName(ownerLastName),
-		  creationTimestamp(creationTimestamp)
-	{
-		std::random_device rd;
-		std::mt19937 gen(rd());
-		if (accountType == EBankAccountType::Loan) {
-			std::uniform_real_distribution<> dis(-50000.0, -25000.0);
-			balance = dis(gen);
-		} else if (accountType == EBankAccountType::Credit) {
-			std::uniform_real_distribution<> dis(-1000.0, 0.0);
-			balance = dis(gen);
-		} else if (accountType == EBankAccountType::Checking ||
-				   accountType == EBankAccountType::Savings ||
-				   accountType == EBankAccountType::Pension) {
-			std::uniform_real_distribution<> dis(0.0, 1000.0);
-			balance = dis(gen);
-		} else {
-			balance = 0.0;
-		}
-	}
+		  ownerFirstNameId(NameDictionary().Intern(ownerFirstName)),
+		  ownerLastNameId(NameDictionary().Intern(ownerLastName)),
+		  creationTimestamp(creationTimestamp),
+		  balance(GenerateBalance(accountType, ThreadLocalGenerator())) {}
+
+	// Draws the balance from the caller's generator so seeded runs are reproducible
+	TBankAccount(TAccountNumber accountNumber,
+				 EBankAccountType accountType,
+				 const std::string& ownerFirstName,
+				 const std::string& ownerLastName,
+				 time_t creationTimestamp,
+				 TXoshiro256& gen)
+		: accountNumber(accountNumber),
+		  accountType(accountType),
+		  ownerFirstNameId(NameDictionary().Intern(ownerFirstName)),
+		  ownerLastNameId(NameDictionary().Intern(ownerLastName)),
+		  creationTimestamp(creationTimestamp),
+		  balance(GenerateBalance(accountType, gen)) {}
+
+	// Uses a known balance, e.g. when materialising a stored account
+	TBankAccount(TAccountNumber accountNumber,
+				 EBankAccountType accountType,
+				 const std::string& ownerFirstName,
+				 const std::string& ownerLastName,
+				 time_t creationTimestamp,
+				 double balance)
+		: accountNumber(accountNumber),
+		  accountType(accountType),
+		  ownerFirstNameId(NameDictionary().Intern(ownerFirstName)),
+		  ownerLastNameId(NameDictionary().Intern(ownerLastName)),
+		  creationTimestamp(creationTimestamp),
+		  balance(balance) {}
+
+	const std::string& OwnerFirstName() const { return NameDictionary().Name(ownerFirstNameId); }
+	const std::string& OwnerLastName() const { return NameDictionary().Name(ownerLastNameId); }
 };
 
 // Simple singly-linked list template used across assignments
@@ -162,42 +879,178 @@ std::vector<std::string> lastNames = {
 	"Foster", "Ferguson", "Freeman", "Fletcher", "Franklin", "Fuller", "Francis", "Fowler"
 };
 
-// Generate random account number
-std::string GenerateAccountNumber(std::mt19937& gen) {
+TNameDictionary& NameDictionary() {
+	static TNameDictionary dictionary([] {
+		std::vector<std::string> catalogue(firstNames);
+		catalogue.insert(catalogue.end(), lastNames.begin(), lastNames.end());
+		return catalogue;
+	}());
+	return dictionary;
+}
+
+// Seed used for the generated data set; fixed so runs are reproducible
+const uint64_t DEFAULT_SEED = 20251104;
+
+// First and last second of a calendar year in local time
+struct TYearBounds {
+	time_t start;
+	time_t end;
+};
+
+TYearBounds ComputeYearBounds(int year) {
+	// January 1, 00:00:00
+	struct tm tmStart = {};
+	tmStart.tm_year = year - 1900;
+	tmStart.tm_mon = 0;
+	tmStart.tm_mday = 1;
+	tmStart.tm_isdst = -1;
+
+	// December 31, 23:59:59
+	struct tm tmEnd = {};
+	tmEnd.tm_year = year - 1900;
+	tmEnd.tm_mon = 11;
+	tmEnd.tm_mday = 31;
+	tmEnd.tm_hour = 23;
+	tmEnd.tm_min = 59;
+	tmEnd.tm_sec = 59;
+	tmEnd.tm_isdst = -1;
+
+	TYearBounds bounds;
+	bounds.start = mktime(&tmStart);
+	bounds.end = mktime(&tmEnd);
+	return bounds;
+}
+
+// 2025 bounds, computed on first use instead of two mktime calls per timestamp
+const TYearBounds& YearBounds2025() {
+	static const TYearBounds bounds = ComputeYearBounds(2025);
+	return bounds;
+}
+
+// Generate random account number ("ACC" + six digits), packed directly without any text
+template<typename Generator>
+TAccountNumber GenerateAccountNumber(Generator& gen) {
 	std::uniform_int_distribution<> dis(100000, 999999);
-	return "ACC" + std::to_string(dis(gen));
-}
-
-// Generate random timestamp
-time_t GenerateRandomTimestamp(std::mt19937& gen) {
-	struct tm tm2025start = {};
-	// tm_year is years since 1900; 125 -> 2025.
-	tm2025start.tm_year = 125;
-	tm2025start.tm_mon = 0;
-	tm2025start.tm_mday = 1;
-	time_t start2025 = mktime(&tm2025start);
-	struct tm tm2025end = {};
-	tm2025end.tm_year = 125;
-	tm2025end.tm_mon = 11;
-	tm2025end.tm_mday = 31;
-	tm2025end.tm_hour = 23; tm2025end.tm_min = 59; tm2025end.tm_sec = 59;
-	time_t end2025 = mktime(&tm2025end);
-	std::uniform_int_distribution<time_t> dis(start2025, end2025);
+	return TAccountNumber(ACC_PREFIX_ID, 6, dis(gen));
+}
+
+// Generate random timestamp within 2025
+template<typename Generator>
+time_t GenerateRandomTimestamp(Generator& gen) {
+	const TYearBounds& bounds = YearBounds2025();
+	std::uniform_int_distribution<time_t> dis(bounds.start, bounds.end);
 	return dis(gen);
 }
 
-EBankAccountType GenerateRandomAccountType(std::mt19937& gen) {
+template<typename Generator>
+EBankAccountType GenerateRandomAccountType(Generator& gen) {
 	std::uniform_int_distribution<> dis(0, 4);
 	return static_cast<EBankAccountType>(dis(gen));
 }
 
+// Column-per-field store for bulk generated accounts. No per-account heap object or string:
+// names are indices into firstNames/lastNames and account numbers keep only the digits after "ACC".
+struct TAccountColumns {
+	std::vector<uint32_t> accountNumbers;
+	std::vector<uint8_t> accountTypes;
+	std::vector<uint16_t> firstNameIds;
+	std::vector<uint16_t> lastNameIds;
+	std::vector<time_t> creationTimestamps;
+	std::vector<double> balances;
+
+	size_t Size() const { return accountNumbers.size(); }
+
+	void Resize(size_t count) {
+		accountNumbers.resize(count);
+		accountTypes.resize(count);
+		firstNameIds.resize(count);
+		lastNameIds.resize(count);
+		creationTimestamps.resize(count);
+		balances.resize(count);
+	}
+
+	TAccountNumber AccountNumber(size_t row) const { return TAccountNumber(ACC_PREFIX_ID, 6, accountNumbers[row]); }
+
+	// Builds a heap TBankAccount for one row; caller owns the result
+	TBankAccount* Materialize(size_t row) const {
+		return new TBankAccount(AccountNumber(row), static_cast<EBankAccountType>(accountTypes[row]),
+								firstNames[firstNameIds[row]], lastNames[lastNameIds[row]],
+								creationTimestamps[row], balances[row]);
+	}
+};
+
+// Rows per generator stream in GenerateAccountsBulk
+const size_t BULK_BLOCK_ROWS = 1 << 16;
+
+// Fills one block of rows from its own stream
+void GenerateAccountBlock(TAccountColumns& out, size_t first, size_t last, TXoshiro256& gen) {
+	TTraceScope trace("GenerateAccountBlock");
+	const TYearBounds& bounds = YearBounds2025();
+	const uint32_t timestampRange = (uint32_t)(bounds.end - bounds.start + 1);
+	const uint32_t firstNameCount = (uint32_t)firstNames.size();
+	const uint32_t lastNameCount = (uint32_t)lastNames.size();
+	for (size_t row = first; row < last; row++) {
+		EBankAccountType accountType = static_cast<EBankAccountType>(gen.NextBelow(5));
+		out.accountNumbers[row] = 100000 + gen.NextBelow(900000);
+		out.accountTypes[row] = static_cast<uint8_t>(accountType);
+		out.firstNameIds[row] = (uint16_t)gen.NextBelow(firstNameCount);
+		out.lastNameIds[row] = (uint16_t)gen.NextBelow(lastNameCount);
+		out.creationTimestamps[row] = bounds.start + gen.NextBelow(timestampRange);
+		out.balances[row] = GenerateBalance(accountType, gen);
+	}
+}
+
+// Generates count accounts into out using threadCount threads (0 = hardware concurrency).
+// Every block of BULK_BLOCK_ROWS rows draws from its own stream derived from (seed, block),
+// so the output is identical for a given seed no matter how many threads run.
+// Time: O(n / threads), Space: O(n)
+void GenerateAccountsBulk(TAccountColumns& out, size_t count, uint64_t seed, unsigned threadCount = 0) {
+	TTraceScope trace("GenerateAccountsBulk");
+	out.Resize(count);
+	size_t blockCount = (count + BULK_BLOCK_ROWS - 1) / BULK_BLOCK_ROWS;
+	if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+	threadCount = (unsigned)std::min<size_t>(threadCount, std::max<size_t>(blockCount, 1));
+
+	auto worker = [&](unsigned threadIndex) {
+		for (size_t block = threadIndex; block < blockCount; block += threadCount) {
+			uint64_t blockKey = block;
+			TXoshiro256 gen(seed ^ TXoshiro256::SplitMix64(blockKey));
+			size_t first = block * BULK_BLOCK_ROWS;
+			GenerateAccountBlock(out, first, std::min(count, first + BULK_BLOCK_ROWS), gen);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned t = 1; t < threadCount; t++) threads.emplace_back(worker, t);
+	worker(0);
+	for (auto& thread : threads) thread.join();
+}
+
 // Comparator callbacks (two required)
 int CompareByLastName(TBankAccount* a, TBankAccount* b) {
 	// lexicographic compare on last name, tie-breaker on first name
+	// Name ids are ordered like the names, so this compares integers rather than characters
 	if (!a || !b) return (a ? 1 : (b ? -1 : 0));
-	int cmp = a->ownerLastName.compare(b->ownerLastName);
+	const TNameDictionary& names = NameDictionary();
+	int cmp = names.Compare(a->ownerLastNameId, b->ownerLastNameId);
 	if (cmp != 0) return cmp;
-	return a->ownerFirstName.compare(b->ownerFirstName);
+	return names.Compare(a->ownerFirstNameId, b->ownerFirstNameId);
+}
+
+// Same order as CompareByLastName but comparing the name strings; kept as the baseline
+int CompareByLastNameText(TBankAccount* a, TBankAccount* b) {
+	if (!a || !b) return (a ? 1 : (b ? -1 : 0));
+	int cmp = a->OwnerLastName().compare(b->OwnerLastName());
+	if (cmp != 0) return cmp;
+	return a->OwnerFirstName().compare(b->OwnerFirstName());
+}
+
+// Account numbers are packed 64-bit keys, so this is a single integer compare
+int CompareByAccountNumber(TBankAccount* a, TBankAccount* b) {
+	if (!a || !b) return (a ? 1 : (b ? -1 : 0));
+	if (a->accountNumber < b->accountNumber) return -1;
+	if (b->accountNumber < a->accountNumber) return 1;
+	return 0;
 }
 
 int CompareByBalance(TBankAccount* a, TBankAccount* b) {
@@ -207,7 +1060,90 @@ int CompareByBalance(TBankAccount* a, TBankAccount* b) {
 	return 0;
 }
 
+// Comparator functors matching the callbacks above. Passed to the TSort templates their calls
+// are direct and can be inlined into the sort loops, unlike FCompareAccounts pointers.
+struct TCompareByLastName {
+	int operator()(TBankAccount* a, TBankAccount* b) const { return CompareByLastName(a, b); }
+};
+
+struct TCompareByBalance {
+	int operator()(TBankAccount* a, TBankAccount* b) const { return CompareByBalance(a, b); }
+};
+
+struct TCompareByAccountNumber {
+	int operator()(TBankAccount* a, TBankAccount* b) const { return CompareByAccountNumber(a, b); }
+};
+
+// Sort keys for TSort::KeySortArray. Each account's key is copied next to its pointer once,
+// so the sort compares contiguous keys instead of dereferencing two accounts per comparison.
+template<typename Key>
+struct TKeyedAccount {
+	Key key;
+	TBankAccount* account;
+};
+
+// Last name then first name as one memcmp-comparable byte string:
+// last name bytes, a 0 separator, first name bytes, zero padding. The separator sorts below any
+// name character, so "Smith" < "Smithson" holds for the bytes just as for the strings.
+// Names that do not fit are cut off and marked truncated.
+struct TNameSortKey {
+	static constexpr size_t SIZE = 23;
+	unsigned char bytes[SIZE];
+	bool truncated;
+};
+
+// Key extractors for KeySortArray
+struct TBalanceKey {
+	double operator()(const TBankAccount* account) const { return account->balance; }
+};
+
+struct TCreationTimeKey {
+	time_t operator()(const TBankAccount* account) const { return account->creationTimestamp; }
+};
+
+// Orders like CompareByLastName
+struct TLastFirstNameKey {
+	TNameSortKey operator()(const TBankAccount* account) const {
+		TNameSortKey key = {};
+		const std::string& lastName = account->OwnerLastName();
+		const std::string& firstName = account->OwnerFirstName();
+		size_t used = std::min(lastName.size(), TNameSortKey::SIZE);
+		memcpy(key.bytes, lastName.data(), used);
+		if (used < TNameSortKey::SIZE) used++; // Separator, already zero
+		size_t firstBytes = std::min(firstName.size(), TNameSortKey::SIZE - used);
+		memcpy(key.bytes + used, firstName.data(), firstBytes);
+		key.truncated = lastName.size() + 1 + firstName.size() > TNameSortKey::SIZE;
+		return key;
+	}
+};
+
+template<typename Key>
+int CompareSortKeys(const TKeyedAccount<Key>& a, const TKeyedAccount<Key>& b) {
+	if (a.key < b.key) return -1;
+	if (b.key < a.key) return 1;
+	return 0;
+}
+
+// Only keys with equal bytes where a name was cut off need the accounts themselves
+int CompareSortKeys(const TKeyedAccount<TNameSortKey>& a, const TKeyedAccount<TNameSortKey>& b) {
+	int cmp = memcmp(a.key.bytes, b.key.bytes, TNameSortKey::SIZE);
+	if (cmp != 0 || (!a.key.truncated && !b.key.truncated)) return cmp;
+	return CompareByLastName(a.account, b.account);
+}
+
+// Counting policies for TSort: whether comparisons and swaps are tallied into OperationSummary.
+// Chosen at compile time, so TNoCounting sorts contain no counter updates at all.
+struct TCountOperations {
+	static constexpr bool ENABLED = true;
+};
+
+struct TNoCounting {
+	static constexpr bool ENABLED = false;
+};
+
 // TSort class: sorting engine that produces sorted arrays/lists of pointers
+// Every sort is a template on the comparator type (a functor or an FCompareAccounts pointer) and
+// on a counting policy. The FCompareAccounts overloads keep the original interface and count.
 class TSort {
 private:
 	TLinkedList<TBankAccount>* originalList;
@@ -219,10 +1155,25 @@ private:
 	int sortedArraySize;
 	bool isArraySorted;
 
-	// Helpers for timing
-	static double NowMs() {
-		auto now = std::chrono::high_resolution_clock::now();
-		return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(now.time_since_epoch()).count();
+	// Adds one to counter only when the policy counts
+	template<typename Counting>
+	static void Count(long long& counter) {
+		if constexpr (Counting::ENABLED) counter++;
+	}
+
+	TBankAccount** CopyOriginalArray() const {
+		TBankAccount** arr = new TBankAccount*[originalArraySize];
+		for (int i = 0; i < originalArraySize; ++i) arr[i] = originalArray[i];
+		return arr;
+	}
+
+	// cache sorted array for binary search (overwrite previous)
+	void CacheSortedArray(TBankAccount** arr) {
+		if (sortedArray) delete[] sortedArray;
+		sortedArraySize = originalArraySize;
+		sortedArray = new TBankAccount*[sortedArraySize];
+		for (int i = 0; i < sortedArraySize; ++i) sortedArray[i] = arr[i];
+		isArraySorted = true;
 	}
 
 public:
@@ -236,44 +1187,44 @@ public:
 
 	// Selection sort on array (returns new array of pointers)
 	// Complexity: Best O(n^2), Average O(n^2), Worst O(n^2). Space O(n) for copy.
-	TBankAccount** SelectionSortArray(FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting = TCountOperations, typename Compare>
+	TBankAccount** SelectionSortArray(Compare cmp, OperationSummary& summary) {
 		summary = OperationSummary();
-		double start = NowMs();
+		TTraceScope trace("TSort::SelectionSortArray");
+		TPerfScope<OperationSummary> scope(summary);
 
 		// Create a copy of pointers
-		TBankAccount** arr = new TBankAccount*[originalArraySize];
-		for (int i = 0; i < originalArraySize; ++i) arr[i] = originalArray[i];
+		TBankAccount** arr = CopyOriginalArray();
 
 		for (int i = 0; i < originalArraySize - 1; ++i) {
 			int minIdx = i;
 			for (int j = i + 1; j < originalArraySize; ++j) {
-				summary.comparisons++;
+				Count<Counting>(summary.comparisons);
 				if (cmp(arr[j], arr[minIdx]) < 0) minIdx = j;
 			}
 			if (minIdx != i) {
 				std::swap(arr[i], arr[minIdx]);
-				summary.swaps++;
+				Count<Counting>(summary.swaps);
 			}
 		}
 
-		double end = NowMs();
-		summary.timeSpentMs = end - start;
-
-		// cache sorted array for binary search (overwrite previous)
-		if (sortedArray) delete[] sortedArray;
-		sortedArraySize = originalArraySize;
-		sortedArray = new TBankAccount*[sortedArraySize];
-		for (int i = 0; i < sortedArraySize; ++i) sortedArray[i] = arr[i];
-		isArraySorted = true;
+		scope.Stop();
 
+		CacheSortedArray(arr);
 		return arr; // caller must delete[] returned array
 	}
 
+	TBankAccount** SelectionSortArray(FCompareAccounts cmp, OperationSummary& summary) {
+		return SelectionSortArray<TCountOperations, FCompareAccounts>(cmp, summary);
+	}
+
 	// Selection sort on linked list: build pointer vector then selection sort
 	// Complexity: Best/Avg/Worst O(n^2). Space O(n).
-	TLinkedList<TBankAccount>* SelectionSortList(FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting = TCountOperations, typename Compare>
+	TLinkedList<TBankAccount>* SelectionSortList(Compare cmp, OperationSummary& summary) {
 		summary = OperationSummary();
-		double start = NowMs();
+		TTraceScope trace("TSort::SelectionSortList");
+		TPerfScope<OperationSummary> scope(summary);
 
 		// gather pointers from list
 		std::vector<TBankAccount*> vec;
@@ -283,137 +1234,143 @@ public:
 		for (int i = 0; i < n - 1; ++i) {
 			int minIdx = i;
 			for (int j = i + 1; j < n; ++j) {
-				summary.comparisons++;
+				Count<Counting>(summary.comparisons);
 				if (cmp(vec[j], vec[minIdx]) < 0) minIdx = j;
 			}
 			if (minIdx != i) {
 				std::swap(vec[i], vec[minIdx]);
-				summary.swaps++;
+				Count<Counting>(summary.swaps);
 			}
 		}
 
 		TLinkedList<TBankAccount>* result = new TLinkedList<TBankAccount>(false);
 		for (auto p : vec) result->add(p);
 
-		double end = NowMs();
-		summary.timeSpentMs = end - start;
 		return result; // caller must delete result (ownsData=false)
 	}
 
+	TLinkedList<TBankAccount>* SelectionSortList(FCompareAccounts cmp, OperationSummary& summary) {
+		return SelectionSortList<TCountOperations, FCompareAccounts>(cmp, summary);
+	}
+
 	// Bubble sort on array (pointer array)
 	// Complexity: Best O(n) (already sorted), Avg/Worst O(n^2). Space O(n) for copy.
-	TBankAccount** BubbleSortArray(FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting = TCountOperations, typename Compare>
+	TBankAccount** BubbleSortArray(Compare cmp, OperationSummary& summary) {
 		summary = OperationSummary();
-		double start = NowMs();
+		TTraceScope trace("TSort::BubbleSortArray");
+		TPerfScope<OperationSummary> scope(summary);
 
-		TBankAccount** arr = new TBankAccount*[originalArraySize];
-		for (int i = 0; i < originalArraySize; ++i) arr[i] = originalArray[i];
+		TBankAccount** arr = CopyOriginalArray();
 
 		bool swapped;
 		for (int pass = 0; pass < originalArraySize - 1; ++pass) {
 			swapped = false;
 			for (int j = 0; j < originalArraySize - 1 - pass; ++j) {
-				summary.comparisons++;
+				Count<Counting>(summary.comparisons);
 				if (cmp(arr[j+1], arr[j]) < 0) {
 					std::swap(arr[j], arr[j+1]);
-					summary.swaps++;
+					Count<Counting>(summary.swaps);
 					swapped = true;
 				}
 			}
 			if (!swapped) break;
 		}
 
-		double end = NowMs();
-		summary.timeSpentMs = end - start;
-
-		// cache sorted array
-		if (sortedArray) delete[] sortedArray;
-		sortedArraySize = originalArraySize;
-		sortedArray = new TBankAccount*[sortedArraySize];
-		for (int i = 0; i < sortedArraySize; ++i) sortedArray[i] = arr[i];
-		isArraySorted = true;
+		scope.Stop();
 
+		CacheSortedArray(arr);
 		return arr;
 	}
 
+	TBankAccount** BubbleSortArray(FCompareAccounts cmp, OperationSummary& summary) {
+		return BubbleSortArray<TCountOperations, FCompareAccounts>(cmp, summary);
+	}
+
 	// QuickSort (array) public/private recursion with Partition helper
 	// Complexity: Best O(n log n), Avg O(n log n), Worst O(n^2) (bad pivot). Space O(log n) stack.
-	TBankAccount** QuickSortArray(FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting = TCountOperations, typename Compare>
+	TBankAccount** QuickSortArray(Compare cmp, OperationSummary& summary) {
 		summary = OperationSummary();
-		double start = NowMs();
+		TTraceScope trace("TSort::QuickSortArray");
+		TPerfScope<OperationSummary> scope(summary);
 
-		TBankAccount** arr = new TBankAccount*[originalArraySize];
-		for (int i = 0; i < originalArraySize; ++i) arr[i] = originalArray[i];
+		TBankAccount** arr = CopyOriginalArray();
 
-		QuickSortRecursive(arr, 0, originalArraySize - 1, cmp, summary);
+		QuickSortRecursive<Counting>(arr, 0, originalArraySize - 1, cmp, summary);
 
-		double end = NowMs();
-		summary.timeSpentMs = end - start;
-
-		// cache sorted array
-		if (sortedArray) delete[] sortedArray;
-		sortedArraySize = originalArraySize;
-		sortedArray = new TBankAccount*[sortedArraySize];
-		for (int i = 0; i < sortedArraySize; ++i) sortedArray[i] = arr[i];
-		isArraySorted = true;
+		scope.Stop();
 
+		CacheSortedArray(arr);
 		return arr;
 	}
 
+	TBankAccount** QuickSortArray(FCompareAccounts cmp, OperationSummary& summary) {
+		return QuickSortArray<TCountOperations, FCompareAccounts>(cmp, summary);
+	}
+
 private:
-	void QuickSortRecursive(TBankAccount** arr, int left, int right, FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting, typename Compare>
+	void QuickSortRecursive(TBankAccount** arr, int left, int right, Compare& cmp, OperationSummary& summary) {
 		if (left >= right) return;
-		int pivotIndex = Partition(arr, left, right, cmp, summary);
-		QuickSortRecursive(arr, left, pivotIndex - 1, cmp, summary);
-		QuickSortRecursive(arr, pivotIndex + 1, right, cmp, summary);
+		int pivotIndex = Partition<Counting>(arr, left, right, cmp, summary);
+		QuickSortRecursive<Counting>(arr, left, pivotIndex - 1, cmp, summary);
+		QuickSortRecursive<Counting>(arr, pivotIndex + 1, right, cmp, summary);
 	}
 
-	int Partition(TBankAccount** arr, int left, int right, FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting, typename Compare>
+	int Partition(TBankAccount** arr, int left, int right, Compare& cmp, OperationSummary& summary) {
 		// Lomuto partition picking rightmost as pivot
 		TBankAccount* pivot = arr[right];
 		int i = left - 1;
 		for (int j = left; j < right; ++j) {
-			summary.comparisons++;
+			Count<Counting>(summary.comparisons);
 			if (cmp(arr[j], pivot) <= 0) {
 				++i;
-				if (i != j) { std::swap(arr[i], arr[j]); summary.swaps++; }
+				if (i != j) { std::swap(arr[i], arr[j]); Count<Counting>(summary.swaps); }
 			}
 		}
-		if (i+1 != right) { std::swap(arr[i+1], arr[right]); summary.swaps++; }
+		if (i+1 != right) { std::swap(arr[i+1], arr[right]); Count<Counting>(summary.swaps); }
 		return i+1;
 	}
 
 public:
 	// Merge sort on linked list. We'll implement via pointer array (stable merge) but use recursive public/private pattern.
 	// Complexity: Best/Average/Worst O(n log n). Space O(n) for auxiliary arrays.
-	TLinkedList<TBankAccount>* MergeSortList(FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting = TCountOperations, typename Compare>
+	TLinkedList<TBankAccount>* MergeSortList(Compare cmp, OperationSummary& summary) {
 		summary = OperationSummary();
-		double start = NowMs();
+		TTraceScope trace("TSort::MergeSortList");
+		TPerfScope<OperationSummary> scope(summary);
 
 		// collect pointers
 		std::vector<TBankAccount*> vec;
 		for (auto it = originalList->begin(); it != originalList->end(); ++it) vec.push_back(*it);
 
-		MergeSortRecursive(vec, 0, (int)vec.size() - 1, cmp, summary);
+		MergeSortRecursive<Counting>(vec, 0, (int)vec.size() - 1, cmp, summary);
 
 		TLinkedList<TBankAccount>* result = new TLinkedList<TBankAccount>(false);
 		for (auto p : vec) result->add(p);
 
-		double end = NowMs();
-		summary.timeSpentMs = end - start;
 		return result;
 	}
 
+	TLinkedList<TBankAccount>* MergeSortList(FCompareAccounts cmp, OperationSummary& summary) {
+		return MergeSortList<TCountOperations, FCompareAccounts>(cmp, summary);
+	}
+
 private:
-	void MergeSortRecursive(std::vector<TBankAccount*>& vec, int left, int right, FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting, typename Compare>
+	void MergeSortRecursive(std::vector<TBankAccount*>& vec, int left, int right, Compare& cmp, OperationSummary& summary) {
 		if (left >= right) return;
 		int mid = left + (right - left) / 2;
-		MergeSortRecursive(vec, left, mid, cmp, summary);
-		MergeSortRecursive(vec, mid+1, right, cmp, summary);
-		Merge(vec, left, mid, right, cmp, summary);
+		MergeSortRecursive<Counting>(vec, left, mid, cmp, summary);
+		MergeSortRecursive<Counting>(vec, mid+1, right, cmp, summary);
+		Merge<Counting>(vec, left, mid, right, cmp, summary);
 	}
 
-	void Merge(std::vector<TBankAccount*>& vec, int left, int mid, int right, FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting, typename Compare>
+	void Merge(std::vector<TBankAccount*>& vec, int left, int mid, int right, Compare& cmp, OperationSummary& summary) {
 		int n1 = mid - left + 1;
 		int n2 = right - mid;
 		std::vector<TBankAccount*> L(n1), R(n2);
@@ -422,7 +1379,7 @@ private:
 
 		int i = 0, j = 0, k = left;
 		while (i < n1 && j < n2) {
-			summary.comparisons++;
+			Count<Counting>(summary.comparisons);
 			if (cmp(L[i], R[j]) <= 0) { vec[k++] = L[i++]; }
 			else { vec[k++] = R[j++]; }
 		}
@@ -431,53 +1388,393 @@ private:
 	}
 
 public:
+	// Key-extraction (Schwartzian) sort: builds a contiguous array of (key, pointer) pairs with
+	// one key extraction per account, sorts it, then emits the pointers in that order.
+	// Comparisons only touch the pair array, not the scattered accounts. Keys come from a
+	// functor such as TBalanceKey, TCreationTimeKey or TLastFirstNameKey.
+	// Complexity: O(n log n) comparisons, n key extractions. Space O(n) for the pairs. Stable.
+	template<typename Counting = TCountOperations, typename KeyExtractor>
+	TBankAccount** KeySortArray(KeyExtractor extract, OperationSummary& summary) {
+		typedef typename std::decay<decltype(extract(originalArray[0]))>::type Key;
+		summary = OperationSummary();
+		TTraceScope trace("TSort::KeySortArray");
+		TPerfScope<OperationSummary> scope(summary);
+
+		std::vector<TKeyedAccount<Key>> keyed(originalArraySize);
+		for (int i = 0; i < originalArraySize; ++i) keyed[i] = TKeyedAccount<Key>{ extract(originalArray[i]), originalArray[i] };
+
+		std::stable_sort(keyed.begin(), keyed.end(), [&](const TKeyedAccount<Key>& a, const TKeyedAccount<Key>& b) {
+			Count<Counting>(summary.comparisons);
+			return CompareSortKeys(a, b) < 0;
+		});
+
+		TBankAccount** arr = new TBankAccount*[originalArraySize];
+		for (int i = 0; i < originalArraySize; ++i) arr[i] = keyed[i].account;
+
+		scope.Stop();
+
+		CacheSortedArray(arr);
+		return arr;
+	}
+
 	// Binary search on cached sorted array. Public/private recursion pattern.
 	// Requires that one of the array-sorting methods was called earlier (isArraySorted == true).
-	TBankAccount* BinarySearch(TBankAccount* key, FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting = TCountOperations, typename Compare>
+	TBankAccount* BinarySearch(TBankAccount* key, Compare cmp, OperationSummary& summary) {
 		summary = OperationSummary();
 		if (!isArraySorted || !sortedArray) return nullptr; // not sorted
-		double start = NowMs();
-		TBankAccount* found = BinarySearchRecursive(0, sortedArraySize - 1, key, cmp, summary);
-		double end = NowMs();
-		summary.timeSpentMs = end - start;
-		return found;
+		TTraceScope trace("TSort::BinarySearch");
+		TPerfScope<OperationSummary> scope(summary);
+		return BinarySearchRecursive<Counting>(0, sortedArraySize - 1, key, cmp, summary);
+	}
+
+	TBankAccount* BinarySearch(TBankAccount* key, FCompareAccounts cmp, OperationSummary& summary) {
+		return BinarySearch<TCountOperations, FCompareAccounts>(key, cmp, summary);
 	}
 
 private:
-	TBankAccount* BinarySearchRecursive(int left, int right, TBankAccount* key, FCompareAccounts cmp, OperationSummary& summary) {
+	template<typename Counting, typename Compare>
+	TBankAccount* BinarySearchRecursive(int left, int right, TBankAccount* key, Compare& cmp, OperationSummary& summary) {
 		if (left > right) return nullptr;
 		int mid = left + (right - left) / 2;
-		summary.comparisons++;
+		Count<Counting>(summary.comparisons);
 		int c = cmp(sortedArray[mid], key);
 		if (c == 0) return sortedArray[mid];
-		if (c < 0) return BinarySearchRecursive(mid + 1, right, key, cmp, summary);
-		return BinarySearchRecursive(left, mid - 1, key, cmp, summary);
+		if (c < 0) return BinarySearchRecursive<Counting>(mid + 1, right, key, cmp, summary);
+		return BinarySearchRecursive<Counting>(left, mid - 1, key, cmp, summary);
 	}
 };
 
 // Linear search (from Assignment 4) to compare comparisons count
 // Returns pointer and populates OperationSummary.comparisons
+// The name is resolved to its id once, so the scan compares integers; a name that was never
+// interned cannot belong to any account and returns nullptr without scanning
 TBankAccount* LinearSearchArrayByLastName(TBankAccount** accountArray, int arraySize, const std::string& lastName, OperationSummary& summary) {
 	summary = OperationSummary();
-	auto start = std::chrono::high_resolution_clock::now();
+	TTraceScope trace("LinearSearchArrayByLastName");
+	TPerfScope<OperationSummary> scope(summary);
+	uint32_t lastNameId;
+	if (!NameDictionary().Find(lastName, lastNameId)) return nullptr;
 	for (int i = 0; i < arraySize; ++i) {
 		summary.comparisons++;
-		if (accountArray[i] && accountArray[i]->ownerLastName == lastName) {
-			auto end = std::chrono::high_resolution_clock::now();
-			summary.timeSpentMs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
-			return accountArray[i];
-		}
+		if (accountArray[i] && accountArray[i]->ownerLastNameId == lastNameId) return accountArray[i];
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	summary.timeSpentMs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
 	return nullptr;
 }
 
-int main() {
+// Benchmark harness, run with --bench. Sweeps input sizes and distributions, runs every TSort
+// sort and search plus the linear search with warmups and repetitions, and writes one row per
+// (algorithm, distribution, n) with time percentiles and operation counts as CSV or JSON.
+// Options:
+//   --sizes 1000,10000,...   input sizes (default 1000,10000,100000; 100M needs roughly 10 GB)
+//   --dist random,sorted,reverse,nearly,fewunique,dupnames   input distributions (default all)
+//   --key balance|name       sort key the distributions and sorts use (default balance); dupnames
+//                            always sorts by name, since under the balance key it only repeats random
+//   --warmup N --reps N      untimed and timed runs per cell (default 1 and 5)
+//   --format csv|json --out FILE   output format and file (default csv on stdout)
+//   --seed N                 seed for the generated accounts
+//   --counters               also record hardware counters (n/a where perf_event_open is refused)
+//   --trace FILE, --trace-folded FILE   also write a Chrome trace / folded stacks of the run
+// The O(n^2) sorts only run up to QUADRATIC_SORT_LIMIT accounts, and so does QuickSortArray on
+// inputs that drive its rightmost-pivot partition quadratic (sorted, reverse, nearly sorted,
+// heavy duplicates).
+const int QUADRATIC_SORT_LIMIT = 20000;
+const int BENCH_BINARY_LOOKUPS = 1000;   // Binary searches timed together per repetition
+const int BENCH_LINEAR_LOOKUPS = 100;    // Linear searches timed together per repetition
+
+struct TBenchConfig {
+	std::vector<int> sizes;
+	std::vector<std::string> distributions;
+	bool byName;
+	int warmups;
+	int repetitions;
+	std::string format;
+	std::string outputPath;
+	uint64_t seed;
+
+	TBenchConfig()
+		: sizes{ 1000, 10000, 100000 },
+		  distributions{ "random", "sorted", "reverse", "nearly", "fewunique", "dupnames" },
+		  byName(false), warmups(1), repetitions(5), format("csv"), seed(DEFAULT_SEED) {}
+};
+
+// Timings and counts for one (algorithm, distribution, n) cell
+struct TBenchResult {
+	std::string algorithm;
+	std::string distribution;
+	std::string key; // Sort key of the cell: "balance" or "name"
+	int n;
+	std::vector<double> timesMs;
+	long long comparisons; // From the last repetition; inputs are identical between repetitions
+	long long swaps;
+	long long bytesAllocated;
+	PerfCounters counters; // From the last repetition
+};
+
+// Value at fraction p (0..1) of sorted samples, interpolating between neighbours
+double Percentile(const std::vector<double>& sorted, double p) {
+	if (sorted.empty()) return 0.0;
+	double position = p * (sorted.size() - 1);
+	size_t below = (size_t)position;
+	size_t above = std::min(below + 1, sorted.size() - 1);
+	return sorted[below] + (sorted[above] - sorted[below]) * (position - below);
+}
+
+// Builds n accounts for a distribution, ordered with respect to cmp where the distribution asks
+// for it. Caller owns the accounts.
+std::vector<TBankAccount*> MakeBenchAccounts(const std::string& distribution, int n, FCompareAccounts cmp, uint64_t seed) {
+	TXoshiro256 gen(seed);
+	const TYearBounds& bounds = YearBounds2025();
+	bool fewUnique = distribution == "fewunique";
+	bool duplicateNames = distribution == "dupnames";
+	std::vector<TBankAccount*> accounts;
+	accounts.reserve(n);
+	for (int i = 0; i < n; ++i) {
+		EBankAccountType type = static_cast<EBankAccountType>(gen.NextBelow(5));
+		// fewunique: 2 x 2 names and 8 balances; dupnames: only 3 last names
+		const std::string& first = firstNames[gen.NextBelow(fewUnique ? 2 : (uint32_t)firstNames.size())];
+		const std::string& last = lastNames[gen.NextBelow(fewUnique ? 2 : duplicateNames ? 3 : (uint32_t)lastNames.size())];
+		double balance = fewUnique ? 100.0 * gen.NextBelow(8) : GenerateBalance(type, gen);
+		time_t timestamp = bounds.start + gen.NextBelow((uint32_t)(bounds.end - bounds.start));
+		accounts.push_back(new TBankAccount(GenerateAccountNumber(gen), type, first, last, timestamp, balance));
+	}
+	if (distribution == "sorted" || distribution == "reverse" || distribution == "nearly") {
+		std::stable_sort(accounts.begin(), accounts.end(), [&](TBankAccount* a, TBankAccount* b) { return cmp(a, b) < 0; });
+	}
+	if (distribution == "reverse") std::reverse(accounts.begin(), accounts.end());
+	if (distribution == "nearly") {
+		for (int i = 0; i < n / 100; ++i) std::swap(accounts[gen.NextBelow(n)], accounts[gen.NextBelow(n)]);
+	}
+	return accounts;
+}
+
+// Runs warmups untimed, then repetitions timed by the OperationSummary that run fills in
+TBenchResult RunBenchCell(const std::string& algorithm, const std::string& distribution, int n, const TBenchConfig& config,
+						  const std::function<void(OperationSummary&)>& run) {
+	TBenchResult result;
+	result.algorithm = algorithm;
+	result.distribution = distribution;
+	result.n = n;
+	OperationSummary summary;
+	for (int i = 0; i < config.warmups; ++i) run(summary);
+	for (int i = 0; i < config.repetitions; ++i) {
+		run(summary);
+		result.timesMs.push_back(summary.timeSpentMs);
+	}
+	result.comparisons = summary.comparisons;
+	result.swaps = summary.swaps;
+	result.bytesAllocated = summary.bytesAllocated;
+	result.counters = summary.counters;
+	std::sort(result.timesMs.begin(), result.timesMs.end());
+	return result;
+}
+
+// Counter value for the output formats; unavailable counters become missingText
+std::string BenchCounter(long long value, const char* missingText) {
+	return value < 0 ? std::string(missingText) : std::to_string(value);
+}
+
+void WriteBenchCsv(std::ostream& out, const std::vector<TBenchResult>& results) {
+	out << "algorithm,distribution,key,n,repetitions,min_ms,median_ms,p90_ms,p99_ms,max_ms,comparisons,swaps,"
+		<< "bytes_allocated,cycles,instructions,cache_misses,branch_misses\n";
+	for (const TBenchResult& r : results) {
+		out << r.algorithm << "," << r.distribution << "," << r.key << "," << r.n << "," << r.timesMs.size() << ","
+			<< r.timesMs.front() << "," << Percentile(r.timesMs, 0.5) << "," << Percentile(r.timesMs, 0.9) << ","
+			<< Percentile(r.timesMs, 0.99) << "," << r.timesMs.back() << "," << r.comparisons << "," << r.swaps << ","
+			<< r.bytesAllocated << "," << BenchCounter(r.counters.cycles, "n/a") << "," << BenchCounter(r.counters.instructions, "n/a") << ","
+			<< BenchCounter(r.counters.cacheMisses, "n/a") << "," << BenchCounter(r.counters.branchMisses, "n/a") << "\n";
+	}
+}
+
+void WriteBenchJson(std::ostream& out, const std::vector<TBenchResult>& results) {
+	out << "[\n";
+	for (size_t i = 0; i < results.size(); ++i) {
+		const TBenchResult& r = results[i];
+		out << "  {\"algorithm\": \"" << r.algorithm << "\", \"distribution\": \"" << r.distribution
+			<< "\", \"key\": \"" << r.key
+			<< "\", \"n\": " << r.n << ", \"repetitions\": " << r.timesMs.size()
+			<< ", \"min_ms\": " << r.timesMs.front() << ", \"median_ms\": " << Percentile(r.timesMs, 0.5)
+			<< ", \"p90_ms\": " << Percentile(r.timesMs, 0.9) << ", \"p99_ms\": " << Percentile(r.timesMs, 0.99)
+			<< ", \"max_ms\": " << r.timesMs.back() << ", \"comparisons\": " << r.comparisons
+			<< ", \"swaps\": " << r.swaps << ", \"bytes_allocated\": " << r.bytesAllocated
+			<< ", \"cycles\": " << BenchCounter(r.counters.cycles, "null") << ", \"instructions\": " << BenchCounter(r.counters.instructions, "null")
+			<< ", \"cache_misses\": " << BenchCounter(r.counters.cacheMisses, "null")
+			<< ", \"branch_misses\": " << BenchCounter(r.counters.branchMisses, "null")
+			<< "}" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "]\n";
+}
+
+// Parses the --bench options; returns false with a message for anything unknown or malformed
+bool ParseBenchArgs(int argc, char** argv, TBenchConfig& config, std::string& error) {
+	auto splitList = [](const std::string& text) {
+		std::vector<std::string> items;
+		std::stringstream stream(text);
+		std::string item;
+		while (std::getline(stream, item, ',')) if (!item.empty()) items.push_back(item);
+		return items;
+	};
+	static const std::vector<std::string> knownDistributions = { "random", "sorted", "reverse", "nearly", "fewunique", "dupnames" };
+	try {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			if (arg == "--bench") continue;
+			if (arg == "--counters") { SetPerfCountersEnabled(true); continue; }
+			if (i + 1 >= argc) { error = "Missing value for " + arg; return false; }
+			std::string value = argv[++i];
+			if (arg == "--sizes") {
+				config.sizes.clear();
+				for (const std::string& size : splitList(value)) {
+					int n = std::stoi(size);
+					if (n < 1) { error = "Sizes must be positive"; return false; }
+					config.sizes.push_back(n);
+				}
+			} else if (arg == "--dist") {
+				config.distributions = splitList(value);
+				for (const std::string& d : config.distributions) {
+					if (std::find(knownDistributions.begin(), knownDistributions.end(), d) == knownDistributions.end()) {
+						error = "Unknown distribution: " + d;
+						return false;
+					}
+				}
+			} else if (arg == "--key") {
+				if (value != "balance" && value != "name") { error = "Key must be balance or name"; return false; }
+				config.byName = value == "name";
+			} else if (arg == "--warmup") {
+				config.warmups = std::max(0, std::stoi(value));
+			} else if (arg == "--reps") {
+				config.repetitions = std::max(1, std::stoi(value));
+			} else if (arg == "--format") {
+				if (value != "csv" && value != "json") { error = "Format must be csv or json"; return false; }
+				config.format = value;
+			} else if (arg == "--out") {
+				config.outputPath = value;
+			} else if (arg == "--seed") {
+				config.seed = std::stoull(value);
+			} else if (arg == "--trace" || arg == "--trace-folded") {
+				// Handled in main
+			} else {
+				error = "Unknown option: " + arg;
+				return false;
+			}
+		}
+	} catch (const std::exception&) {
+		error = "Malformed number in arguments";
+		return false;
+	}
+	return true;
+}
+
+// Runs the whole sweep; progress goes to stderr so stdout carries only the results
+int RunBenchmarks(const TBenchConfig& config) {
+	std::vector<TBenchResult> results;
+	for (int n : config.sizes) {
+		for (const std::string& distribution : config.distributions) {
+			// dupnames only differs from random in its last names, so it is always sorted by name
+			bool byName = config.byName || distribution == "dupnames";
+			FCompareAccounts cmp = byName ? CompareByLastName : CompareByBalance;
+			size_t firstRow = results.size();
+			std::cerr << "bench: n=" << n << " distribution=" << distribution << " key=" << (byName ? "name" : "balance") << std::endl;
+			std::vector<TBankAccount*> accounts = MakeBenchAccounts(distribution, n, cmp, config.seed);
+			TLinkedList<TBankAccount> list(false);
+			for (TBankAccount* account : accounts) list.add(account);
+			TSort sorter(&list, accounts.data(), n);
+			bool quadraticInput = distribution != "random";
+
+			if (n <= QUADRATIC_SORT_LIMIT) {
+				results.push_back(RunBenchCell("SelectionSortArray", distribution, n, config, [&](OperationSummary& s) { delete[] sorter.SelectionSortArray(cmp, s); }));
+				results.push_back(RunBenchCell("SelectionSortList", distribution, n, config, [&](OperationSummary& s) { delete sorter.SelectionSortList(cmp, s); }));
+				results.push_back(RunBenchCell("BubbleSortArray", distribution, n, config, [&](OperationSummary& s) { delete[] sorter.BubbleSortArray(cmp, s); }));
+			}
+			if (n <= QUADRATIC_SORT_LIMIT || !quadraticInput) {
+				results.push_back(RunBenchCell("QuickSortArray", distribution, n, config, [&](OperationSummary& s) { delete[] sorter.QuickSortArray(cmp, s); }));
+			}
+			results.push_back(RunBenchCell("MergeSortList", distribution, n, config, [&](OperationSummary& s) { delete sorter.MergeSortList(cmp, s); }));
+			results.push_back(RunBenchCell("KeySortArray", distribution, n, config, [&](OperationSummary& s) {
+				delete[] (byName ? sorter.KeySortArray(TLastFirstNameKey(), s) : sorter.KeySortArray(TBalanceKey(), s));
+			}));
+
+			// Searches: lookup keys are drawn from the accounts; the last KeySortArray left the sorted cache
+			TXoshiro256 keyGen(config.seed ^ (uint64_t)n);
+			std::vector<TBankAccount*> binaryKeys(BENCH_BINARY_LOOKUPS), linearKeys(BENCH_LINEAR_LOOKUPS);
+			for (TBankAccount*& key : binaryKeys) key = accounts[keyGen.NextBelow(n)];
+			for (TBankAccount*& key : linearKeys) key = accounts[keyGen.NextBelow(n)];
+			results.push_back(RunBenchCell("BinarySearch x" + std::to_string(BENCH_BINARY_LOOKUPS), distribution, n, config, [&](OperationSummary& s) {
+				s = OperationSummary();
+				TPerfScope<OperationSummary> scope(s);
+				OperationSummary one;
+				for (TBankAccount* key : binaryKeys) {
+					sorter.BinarySearch(key, cmp, one);
+					s.comparisons += one.comparisons;
+				}
+			}));
+			results.push_back(RunBenchCell("LinearSearchArrayByLastName x" + std::to_string(BENCH_LINEAR_LOOKUPS), distribution, n, config, [&](OperationSummary& s) {
+				s = OperationSummary();
+				TPerfScope<OperationSummary> scope(s);
+				OperationSummary one;
+				for (TBankAccount* key : linearKeys) {
+					LinearSearchArrayByLastName(accounts.data(), n, key->OwnerLastName(), one);
+					s.comparisons += one.comparisons;
+				}
+			}));
+
+			for (size_t row = firstRow; row < results.size(); ++row) results[row].key = byName ? "name" : "balance";
+			for (TBankAccount* account : accounts) delete account;
+		}
+	}
+
+	std::ofstream file;
+	if (!config.outputPath.empty()) {
+		file.open(config.outputPath);
+		if (!file) {
+			std::cerr << "bench: cannot write " << config.outputPath << std::endl;
+			return 1;
+		}
+	}
+	std::ostream& out = config.outputPath.empty() ? std::cout : file;
+	if (config.format == "json") WriteBenchJson(out, results);
+	else WriteBenchCsv(out, results);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	// --bench runs the benchmark suite instead of the demo
+	// --counters attaches hardware counters to every measured sort and search
+	// --trace FILE / --trace-folded FILE record trace scopes and write them as Chrome JSON /
+	// folded stacks when the run ends
+	bool benchMode = false;
+	std::string traceChromePath, traceFoldedPath;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		benchMode = benchMode || arg == "--bench";
+		if (arg == "--counters") SetPerfCountersEnabled(true);
+		if (arg == "--trace" || arg == "--trace-folded") {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << std::endl;
+				return 1;
+			}
+			(arg == "--trace" ? traceChromePath : traceFoldedPath) = argv[++i];
+			SetTracingEnabled(true);
+		}
+	}
+	if (benchMode) {
+		TBenchConfig config;
+		std::string error;
+		if (!ParseBenchArgs(argc, argv, config, error)) {
+			std::cerr << error << "\nUsage: " << argv[0] << " --bench [--sizes 1000,10000] [--dist random,sorted,reverse,nearly,fewunique,dupnames]"
+					  << " [--key balance|name] [--warmup N] [--reps N] [--format csv|json] [--out FILE] [--seed N] [--counters]"
+					  << " [--trace FILE] [--trace-folded FILE]" << std::endl;
+			return 1;
+		}
+		int status = RunBenchmarks(config);
+		if (TracingEnabled() && !WriteTraceFiles(traceChromePath, traceFoldedPath)) status = 1;
+		return status;
+	}
+
 	std::cout << "=== Assignment 5: Sorting Toolkit & Performance Battle ===\n";
 
 	// Setup RNG and create data structures (reuse the same approach as assignment 4)
-	std::random_device rd; std::mt19937 gen(rd());
+	TXoshiro256 gen(DEFAULT_SEED); // seeded, so every run sorts the same accounts
 	TLinkedList<TBankAccount> accountList(true);
 	const int maxAccounts = 6000;
 	TBankAccount** accountArray = new TBankAccount*[maxAccounts];
@@ -488,14 +1785,14 @@ int main() {
 	std::uniform_int_distribution<> accountsPerNameDis(5, 10);
 
 	for (int i = 0; i < 700 && arraySize < maxAccounts; ++i) {
-		std::string firstName = firstNames[nameFirstDis(gen)];
-		std::string lastName = lastNames[nameLastDis(gen)];
+		const std::string& firstName = firstNames[nameFirstDis(gen)];
+		const std::string& lastName = lastNames[nameLastDis(gen)];
 		int accountsForThisName = accountsPerNameDis(gen);
 		for (int j = 0; j < accountsForThisName && arraySize < maxAccounts; ++j) {
-			std::string accountNumber = GenerateAccountNumber(gen);
+			TAccountNumber accountNumber = GenerateAccountNumber(gen);
 			EBankAccountType accountType = GenerateRandomAccountType(gen);
 			time_t timestamp = GenerateRandomTimestamp(gen);
-			TBankAccount* account = new TBankAccount(accountNumber, accountType, firstName, lastName, timestamp);
+			TBankAccount* account = new TBankAccount(accountNumber, accountType, firstName, lastName, timestamp, gen);
 			accountList.add(account);
 			accountArray[arraySize++] = account;
 		}
@@ -525,10 +1822,18 @@ int main() {
 	std::cout << "QuickArray\t" << sQuickArr.comparisons << "\t\t" << sQuickArr.swaps << "\t" << sQuickArr.timeSpentMs << "\n";
 	std::cout << "MergeList\t" << sMergeList.comparisons << "\t\t" << sMergeList.swaps << "\t" << sMergeList.timeSpentMs << "\n";
 
+	// Why the fast sorts are fast: allocation volume and hardware counters (run with --counters)
+	std::cout << "\nSort\t\tTime(ns)\tBytes allocated\tHardware counters\n";
+	std::cout << "SelectionArray\t" << sSelectionArr.timeSpentNs << "\t" << sSelectionArr.bytesAllocated << "\t\t" << FormatPerfCounters(sSelectionArr.counters) << "\n";
+	std::cout << "SelectionList\t" << sSelectionList.timeSpentNs << "\t" << sSelectionList.bytesAllocated << "\t\t" << FormatPerfCounters(sSelectionList.counters) << "\n";
+	std::cout << "BubbleArray\t" << sBubbleArr.timeSpentNs << "\t" << sBubbleArr.bytesAllocated << "\t\t" << FormatPerfCounters(sBubbleArr.counters) << "\n";
+	std::cout << "QuickArray\t" << sQuickArr.timeSpentNs << "\t" << sQuickArr.bytesAllocated << "\t\t" << FormatPerfCounters(sQuickArr.counters) << "\n";
+	std::cout << "MergeList\t" << sMergeList.timeSpentNs << "\t" << sMergeList.bytesAllocated << "\t\t" << FormatPerfCounters(sMergeList.counters) << "\n";
+
 	// Demonstrate binary search vs linear search comparisons
 	// Pick a target account from array (middle)
 	TBankAccount* target = accountArray[arraySize/2];
-	std::string targetLast = target->ownerLastName;
+	std::string targetLast = target->OwnerLastName();
 
 	// Linear search comparisons
 	OperationSummary linSummary;
@@ -542,11 +1847,177 @@ int main() {
 	std::cout << "Linear search comparisons: " << linSummary.comparisons << ", time(ms): " << linSummary.timeSpentMs << "\n";
 	std::cout << "Binary search comparisons: " << binSummary.comparisons << ", time(ms): " << binSummary.timeSpentMs << "\n";
 
+	// Name dictionary: owner names are stored as ordered 32-bit ids
+	std::cout << "\n--- Name Dictionary ---\n";
+	TNameDictionary& names = NameDictionary();
+	std::cout << "Distinct names: " << names.Size() << ", sizeof(TBankAccount): " << sizeof(TBankAccount)
+			  << " bytes (" << sizeof(TBankAccount) - 2 * sizeof(uint32_t) + 2 * sizeof(std::string)
+			  << " with two std::string names)\n";
+	for (const char* lateName : { "Aaron", "Smithson", "Zimmerman" }) {
+		uint32_t id = names.Intern(lateName);
+		std::cout << "Interned '" << lateName << "' later: id " << id
+				  << (TNameDictionary::IsOrdered(id) ? " (ordered)" : " (string fallback)") << "\n";
+	}
+	const int sortRepetitions = 20;
+	double idMs = 0.0, textMs = 0.0;
+	bool sameOrder = true;
+	for (int rep = 0; rep < sortRepetitions; ++rep) {
+		OperationSummary idSummary, textSummary;
+		TBankAccount** byId = sorter.QuickSortArray(CompareByLastName, idSummary);
+		TBankAccount** byText = sorter.QuickSortArray(CompareByLastNameText, textSummary);
+		idMs += idSummary.timeSpentMs;
+		textMs += textSummary.timeSpentMs;
+		for (int i = 0; i < arraySize; ++i) sameOrder = sameOrder && byId[i] == byText[i];
+		delete[] byId; delete[] byText;
+	}
+	OperationSummary numberSummary;
+	TBankAccount** byNumber = sorter.QuickSortArray(CompareByAccountNumber, numberSummary);
+	std::cout << "QuickSortArray by packed account number: " << numberSummary.comparisons << " comparisons, "
+			  << numberSummary.timeSpentMs << " ms, first " << byNumber[0]->accountNumber << ", last "
+			  << byNumber[arraySize - 1]->accountNumber << "\n";
+	delete[] byNumber;
+	std::cout << "QuickSortArray x" << sortRepetitions << " by last name: ids " << idMs << " ms, strings via Name() " << textMs
+			  << " ms, same order: " << (sameOrder ? "Yes" : "No") << "\n";
+
+	// Comparator dispatch: FCompareAccounts pointer vs inlinable functor, with and without counting.
+	// Sorting by balance keeps the comparison itself cheap, so the call overhead is what shows.
+	std::cout << "\n--- Comparator Dispatch (by balance, " << arraySize << " accounts) ---\n";
+	std::cout << "Sort\t\tFunction ptr(ms)\tFunctor(ms)\tFunctor, no counting(ms)\n";
+	{
+		auto timeSort = [](int repetitions, const std::function<void(OperationSummary&)>& run) {
+			double total = 0.0;
+			for (int rep = 0; rep < repetitions; ++rep) {
+				OperationSummary summary;
+				run(summary);
+				total += summary.timeSpentMs;
+			}
+			return total / repetitions;
+		};
+		const int fastRepetitions = 20;
+		double selPtr = timeSort(1, [&](OperationSummary& s) { delete[] sorter.SelectionSortArray(CompareByBalance, s); });
+		double selFunctor = timeSort(1, [&](OperationSummary& s) { delete[] sorter.SelectionSortArray(TCompareByBalance(), s); });
+		double selPlain = timeSort(1, [&](OperationSummary& s) { delete[] sorter.SelectionSortArray<TNoCounting>(TCompareByBalance(), s); });
+		std::cout << "SelectionArray\t" << selPtr << "\t\t\t" << selFunctor << "\t\t" << selPlain << "\n";
+		double quickPtr = timeSort(fastRepetitions, [&](OperationSummary& s) { delete[] sorter.QuickSortArray(CompareByBalance, s); });
+		double quickFunctor = timeSort(fastRepetitions, [&](OperationSummary& s) { delete[] sorter.QuickSortArray(TCompareByBalance(), s); });
+		double quickPlain = timeSort(fastRepetitions, [&](OperationSummary& s) { delete[] sorter.QuickSortArray<TNoCounting>(TCompareByBalance(), s); });
+		std::cout << "QuickArray\t" << quickPtr << "\t\t\t" << quickFunctor << "\t\t" << quickPlain << "\n";
+		double mergePtr = timeSort(fastRepetitions, [&](OperationSummary& s) { delete sorter.MergeSortList(CompareByBalance, s); });
+		double mergeFunctor = timeSort(fastRepetitions, [&](OperationSummary& s) { delete sorter.MergeSortList(TCompareByBalance(), s); });
+		double mergePlain = timeSort(fastRepetitions, [&](OperationSummary& s) { delete sorter.MergeSortList<TNoCounting>(TCompareByBalance(), s); });
+		std::cout << "MergeList\t" << mergePtr << "\t\t\t" << mergeFunctor << "\t\t" << mergePlain << "\n";
+
+		OperationSummary uncounted;
+		delete[] sorter.QuickSortArray<TNoCounting>(TCompareByBalance(), uncounted);
+		std::cout << "TNoCounting summary: " << uncounted.comparisons << " comparisons, " << uncounted.swaps
+				  << " swaps recorded (only time is kept)\n";
+	}
+
+	// Key-extraction sorts against pointer sorts on a larger, scattered data set
+	{
+		const int keySortCount = 2000000;
+		std::cout << "\n--- Key-Extraction Sort (" << keySortCount << " accounts) ---\n";
+		TAccountColumns columns;
+		GenerateAccountsBulk(columns, keySortCount, DEFAULT_SEED);
+		TLinkedList<TBankAccount> bigList(true);
+		TBankAccount** bigArray = new TBankAccount*[keySortCount];
+		for (int i = 0; i < keySortCount; ++i) {
+			bigArray[i] = columns.Materialize(i);
+			bigList.add(bigArray[i]);
+		}
+		TSort bigSorter(&bigList, bigArray, keySortCount);
+
+		// Both results must be sorted under cmp, and identical when expectSame (stable or unique keys)
+		auto report = [&](const char* name, const char* pointerSort, double pointerMs, TBankAccount** pointerOrder,
+						  double keyMs, TBankAccount** keyOrder, FCompareAccounts cmp) {
+			bool sorted = true, same = true;
+			for (int i = 0; i < keySortCount; ++i) {
+				if (i > 0 && cmp(keyOrder[i - 1], keyOrder[i]) > 0) sorted = false;
+				if (pointerOrder[i] != keyOrder[i]) same = false;
+			}
+			std::cout << name << "\t" << pointerSort << "\t" << pointerMs << "\t\t" << keyMs << "\t\t"
+					  << (sorted ? "Yes" : "No") << "\t" << (same ? "Yes" : "No") << "\n";
+		};
+		std::cout << "Key\t\tPointer sort\tPointer(ms)\tKey sort(ms)\tSorted\tSame order\n";
+
+		OperationSummary pointerSummary, keySummary;
+		TBankAccount** byPointer = bigSorter.QuickSortArray<TNoCounting>(TCompareByBalance(), pointerSummary);
+		TBankAccount** byKey = bigSorter.KeySortArray<TNoCounting>(TBalanceKey(), keySummary);
+		report("Balance\t", "QuickSortArray", pointerSummary.timeSpentMs, byPointer, keySummary.timeSpentMs, byKey, CompareByBalance);
+		delete[] byPointer; delete[] byKey;
+
+		// Lomuto quicksort degrades on the many equal names, so names compare against the stable merge sort
+		TLinkedList<TBankAccount>* mergedList = bigSorter.MergeSortList<TNoCounting>(TCompareByLastName(), pointerSummary);
+		std::vector<TBankAccount*> merged;
+		for (auto it = mergedList->begin(); it != mergedList->end(); ++it) merged.push_back(*it);
+		byKey = bigSorter.KeySortArray<TNoCounting>(TLastFirstNameKey(), keySummary);
+		report("Last, first\t", "MergeSortList", pointerSummary.timeSpentMs, merged.data(), keySummary.timeSpentMs, byKey, CompareByLastName);
+		delete mergedList; delete[] byKey;
+
+		OperationSummary timeSummary;
+		byKey = bigSorter.KeySortArray<TNoCounting>(TCreationTimeKey(), timeSummary);
+		bool timeSorted = true;
+		for (int i = 1; i < keySortCount; ++i) timeSorted = timeSorted && byKey[i - 1]->creationTimestamp <= byKey[i]->creationTimestamp;
+		std::cout << "Created\t\tKeySortArray only\t\t" << timeSummary.timeSpentMs << "\t\t" << (timeSorted ? "Yes" : "No") << "\n";
+		delete[] byKey;
+		delete[] bigArray;
+	}
+
 	// Cleanup returned/allocated arrays and lists
 	delete[] selArr; delete selList; delete[] bubArr; delete[] quickArr; delete mergeList;
 	delete[] accountArray; // accountList owns data and will delete in destructor
 
+	// Bulk generation: heap objects one at a time vs the columnar generator
+	std::cout << "\n--- Bulk Account Generation (seed " << DEFAULT_SEED << ") ---" << std::endl;
+	{
+		const size_t objectCount = 200000;
+		const size_t bulkCount = 4000000;
+		std::cout << "Method\t\t\tRows\tTime(ms)\tRows/s" << std::endl;
+
+		auto start = std::chrono::steady_clock::now();
+		TXoshiro256 objectGen(DEFAULT_SEED);
+		std::vector<TBankAccount*> objects;
+		objects.reserve(objectCount);
+		for (size_t i = 0; i < objectCount; i++) {
+			objects.push_back(new TBankAccount(GenerateAccountNumber(objectGen),
+											   GenerateRandomAccountType(objectGen),
+											   firstNames[objectGen.NextBelow((uint32_t)firstNames.size())],
+											   lastNames[objectGen.NextBelow((uint32_t)lastNames.size())],
+											   GenerateRandomTimestamp(objectGen), objectGen));
+		}
+		double objectMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "TBankAccount objects\t" << objectCount << "\t" << objectMs
+				  << "\t" << objectCount / (objectMs / 1000.0) << std::endl;
+		for (TBankAccount* account : objects) delete account;
+
+		TAccountColumns single, parallel;
+		start = std::chrono::steady_clock::now();
+		GenerateAccountsBulk(single, bulkCount, DEFAULT_SEED, 1);
+		double singleMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "Columnar, 1 thread\t" << bulkCount << "\t" << singleMs
+				  << "\t" << bulkCount / (singleMs / 1000.0) << std::endl;
+
+		// At least 4 threads so the determinism check below also means something on small machines
+		unsigned threadCount = std::max(4u, std::thread::hardware_concurrency());
+		start = std::chrono::steady_clock::now();
+		GenerateAccountsBulk(parallel, bulkCount, DEFAULT_SEED, threadCount);
+		double parallelMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "Columnar, " << threadCount << " threads\t" << bulkCount << "\t" << parallelMs
+				  << "\t" << bulkCount / (parallelMs / 1000.0) << std::endl;
+
+		bool identical = single.accountNumbers == parallel.accountNumbers &&
+						 single.creationTimestamps == parallel.creationTimestamps &&
+						 single.balances == parallel.balances;
+		std::cout << "Same rows for 1 and " << threadCount << " threads: " << (identical ? "Yes" : "No") << std::endl;
+
+		TBankAccount* sample = single.Materialize(0);
+		std::cout << "Row 0: " << sample->accountNumber << " - " << sample->OwnerFirstName() << " "
+				  << sample->OwnerLastName() << ", $" << sample->balance << std::endl;
+		delete sample;
+	}
+
 	std::cout << "\nDone. Results show O(n^2) sorts cost far more comparisons/time than O(n log n) sorts." << std::endl;
+	if (TracingEnabled() && !WriteTraceFiles(traceChromePath, traceFoldedPath)) return 1;
 	return 0;
 }
 